@@ -26,6 +26,9 @@
 #include "cat/utility/cat_time.h"
 #include "cat/utility/cat_console.h"
 #include "cat/utility/cat_memory.h"
+#include "cat/utility/cat_object_pool.h"
+#include "cat/utility/cat_vector.h"
+#include "cat/utility/cat_hash_map.h"
 #include "cat/utility/cat_thread.h"
 
 
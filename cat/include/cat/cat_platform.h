@@ -50,9 +50,11 @@
 #ifdef _WIN32
 #define cat_noinl __declspec(noinline)
 #define cat_doinl __forceinline
+#define cat_target(isa)
 #else // #ifdef _WIN32
 #define cat_noinl __attribute__((noinline))
 #define cat_doinl __attribute__((always_inline))
+#define cat_target(isa) __attribute__((target(isa)))
 #endif // #else // #ifdef _WIN32
 
 #define cat_decl
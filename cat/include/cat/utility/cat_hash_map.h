@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*! \file cat_hash_map.h
+*   \brief Open-addressing hash map interface.
+*/
+
+#ifndef _CAT_HASH_MAP_H_
+#define _CAT_HASH_MAP_H_
+
+
+#include "cat/utility/cat_memory.h"
+
+
+cat_interface_begin;
+
+
+//! \def CAT_HASH_MAP_GROUP
+//! \brief Number of control bytes probed at once.
+#define CAT_HASH_MAP_GROUP 16
+
+//! \typedef cat_hash_map_hash_t
+//! \brief Key hash function; all 64 bits should be well mixed since low 7 bits are kept as tag and rest select slot.
+typedef uint64_t(*cat_hash_map_hash_t)(void const* const p_key, size_t const key_size, uint64_t const seed);
+
+//! \typedef cat_hash_map_equal_t
+//! \brief Key equality function.
+typedef bool(*cat_hash_map_equal_t)(void const* const p_key_lh, void const* const p_key_rh, size_t const key_size);
+
+//! \struct cat_hash_map_s
+//! \brief Open-addressing hash map of fixed-size keys and values; one control byte per slot holds tag of hash or empty marker,
+//! groups of control bytes are compared at once and erase shifts entries back so there are no tombstones.
+typedef struct cat_hash_map_s
+{
+    cat_memory_allocator_t allocator; //< Source of storage.
+    cat_hash_map_hash_t    hash;      //< Key hash function.
+    cat_hash_map_equal_t   equal;     //< Key equality function.
+    uint8_t*               p_ctrl;    //< Control byte per slot, followed by copy of first group so groups can be loaded past end.
+    uint8_t*               p_slot;    //< Slots; value follows key in each.
+    size_t                 key_size;  //< Size of key in bytes.
+    size_t                 value_size;//< Size of value in bytes.
+    size_t                 slot_size; //< Size of slot in bytes, rounded for alignment.
+    size_t                 capacity;  //< Number of slots; zero or power of two.
+    size_t                 count;     //< Number of entries.
+    uint64_t               seed;      //< Hash seed.
+} cat_hash_map_t;
+
+
+//! \fn cat_hash_map_init
+//! \brief Initialize hash map.
+//! \param p_map Pointer to map.
+//! \param p_allocator Pointer to allocator, copied into map; null for system heap.
+//! \param key_size Size of key in bytes.
+//! \param value_size Size of value in bytes; may be zero for set.
+//! \param hash Key hash function; null to hash key bytes.
+//! \param equal Key equality function; null to compare key bytes.
+//! \param count Number of entries to reserve for; may be zero.
+//! \return True if successful.
+cat_decl bool cat_hash_map_init(cat_hash_map_t* const p_map, cat_memory_allocator_t const* const p_allocator, size_t const key_size, size_t const value_size,
+    cat_hash_map_hash_t const hash, cat_hash_map_equal_t const equal, size_t const count);
+
+//! \fn cat_hash_map_term
+//! \brief Release hash map storage.
+//! \param p_map Pointer to map.
+//! \return True if successful.
+cat_decl bool cat_hash_map_term(cat_hash_map_t* const p_map);
+
+//! \fn cat_hash_map_reserve
+//! \brief Grow storage so given number of entries fit without rehash; load factor is kept at or below 7/8.
+//! \param p_map Pointer to map.
+//! \param count Number of entries.
+//! \return True if successful.
+cat_decl bool cat_hash_map_reserve(cat_hash_map_t* const p_map, size_t const count);
+
+//! \fn cat_hash_map_clear
+//! \brief Remove all entries; storage is kept.
+//! \param p_map Pointer to map.
+//! \return True if successful.
+cat_decl bool cat_hash_map_clear(cat_hash_map_t* const p_map);
+
+//! \fn cat_hash_map_find
+//! \brief Look up value by key.
+//! \param p_map Pointer to map.
+//! \param p_key Pointer to key.
+//! \return Pointer to value if found; null otherwise. Pointer is invalidated by insert or erase.
+cat_decl void* cat_hash_map_find(cat_hash_map_t const* const p_map, void const* const p_key);
+
+//! \fn cat_hash_map_insert
+//! \brief Insert entry if key is not present.
+//! \param p_map Pointer to map.
+//! \param p_key Pointer to key.
+//! \param p_value Pointer to value to copy for new entry; null to zero it.
+//! \param p_inserted_out Optional pointer to store whether entry is new.
+//! \return Pointer to value of new or existing entry; null if storage could not grow.
+cat_decl void* cat_hash_map_insert(cat_hash_map_t* const p_map, void const* const p_key, void const* const p_value, bool* const p_inserted_out);
+
+//! \fn cat_hash_map_erase
+//! \brief Remove entry by key.
+//! \param p_map Pointer to map.
+//! \param p_key Pointer to key.
+//! \return True if entry was found and removed.
+cat_decl bool cat_hash_map_erase(cat_hash_map_t* const p_map, void const* const p_key);
+
+//! \fn cat_hash_map_next
+//! \brief Iterate over entries in slot order; entries must not be inserted or erased while iterating.
+//! \param p_map Pointer to map.
+//! \param p_cursor Pointer to cursor; set to zero to start.
+//! \param pp_key_out Optional pointer to store pointer to key.
+//! \return Pointer to value of next entry; null when done.
+cat_decl void* cat_hash_map_next(cat_hash_map_t const* const p_map, size_t* const p_cursor, void const** const pp_key_out);
+
+
+cat_interface_end;
+
+
+#endif // #ifndef _CAT_HASH_MAP_H_
\ No newline at end of file
@@ -23,13 +23,199 @@
 
 
 #include "cat/cat_platform.h"
+#include <threads.h>
 
 
 cat_interface_begin;
 
 
+//! \enum cat_memory_simd_e
+//! \brief Instruction set used by block set, copy and compare kernels.
+typedef enum cat_memory_simd_e
+{
+    cat_memory_simd_none,  // Standard library functions.
+    cat_memory_simd_sse2,  // 16-byte vectors.
+    cat_memory_simd_avx2,  // 32-byte vectors.
+    cat_memory_simd_avx512,// 64-byte vectors; requires AVX-512F and AVX-512BW.
+} cat_memory_simd_t;
+
+//! \enum cat_memory_policy_e
+//! \brief Free block search policy for managed memory pool.
+typedef enum cat_memory_policy_e
+{
+    cat_memory_policy_first_fit,// Use first free block that is large enough.
+    cat_memory_policy_best_fit, // Use smallest free block that is large enough.
+} cat_memory_policy_t;
+
+//! \enum cat_memory_pool_flag_e
+//! \brief Managed memory pool creation flags.
+typedef enum cat_memory_pool_flag_e
+{
+    cat_memory_pool_flag_concurrent = 0x01,// Pool is shared by threads; small blocks go through per-thread caches.
+    cat_memory_pool_flag_mapped     = 0x02,// Reserve pool as address space mapping instead of heap block; pages are committed on first touch.
+    cat_memory_pool_flag_huge_pages = 0x04,// Mapped pool aligned and advised for transparent huge pages (Linux).
+    cat_memory_pool_flag_huge_tlb   = 0x08,// Mapped pool from explicit huge pages if reserved, otherwise as huge_pages (Linux).
+    cat_memory_pool_flag_prefault   = 0x10,// Mapped pool is populated up front instead of on first touch (Linux).
+    cat_memory_pool_flag_node_local = 0x20,// Mapped pool with pages bound to NUMA node of creating thread instead of node of first toucher.
+} cat_memory_pool_flag_t;
+
+//! \enum cat_memory_backend_e
+//! \brief Allocator for general (non-slab) blocks of managed memory pool.
+typedef enum cat_memory_backend_e
+{
+    cat_memory_backend_free_list,// Boundary-tagged blocks in a free list with split and coalesce; uses search policy.
+    cat_memory_backend_buddy,    // Power-of-two blocks with per-order free lists and bitmaps; O(log n) alloc and free.
+} cat_memory_backend_t;
+
+//! \enum cat_memory_allocator_kind_e
+//! \brief Source of blocks behind generic allocator.
+typedef enum cat_memory_allocator_kind_e
+{
+    cat_memory_allocator_kind_heap, // System heap through malloc wrappers.
+    cat_memory_allocator_kind_pool, // Managed memory pool instance.
+    cat_memory_allocator_kind_arena,// Linear arena; only most recent block is resized or released in place.
+} cat_memory_allocator_kind_t;
+
+//! \struct cat_memory_pool_desc_s
+//! \brief Managed memory pool creation descriptor.
+typedef struct cat_memory_pool_desc_s
+{
+    size_t               size;   //< Size of pool in bytes.
+    cat_memory_policy_t  policy; //< Free block search policy.
+    uint32_t             flags;  //< Combination of pool creation flags.
+    cat_memory_backend_t backend;//< General block allocator; free list is default.
+    uint32_t             reserved;//< Must be zero.
+} cat_memory_pool_desc_t;
+
+//! \def CAT_MEMORY_SLAB_CLASSES
+//! \brief Number of power-of-two slab size classes (16 to 2048 bytes).
+#define CAT_MEMORY_SLAB_CLASSES 8
+
+//! \def CAT_MEMORY_HISTOGRAM_BINS
+//! \brief Number of log2 size bins in pool statistics; bin n counts blocks of 2^n bytes up to 2^(n+1), last bin counts all larger.
+#define CAT_MEMORY_HISTOGRAM_BINS 32
+
+//! \def CAT_MEMORY_GUARD_SAMPLE_RATE
+//! \brief Default mean number of allocations per guarded one.
+#define CAT_MEMORY_GUARD_SAMPLE_RATE 5000
+
+//! \def CAT_MEMORY_GUARD_SLOTS
+//! \brief Default maximum number of guarded blocks live at once.
+#define CAT_MEMORY_GUARD_SLOTS 64
+
+//! \struct cat_memory_slab_class_s
+//! \brief Slab size class state; each class has its own lock in a concurrent pool.
+typedef struct cat_memory_slab_class_s
+{
+    struct cat_memory_slab_s* p_partial;//< Slabs with free objects.
+    uint32_t                  live;     //< Objects handed out, including those held in thread caches.
+    uint32_t                  reserved; //< Keeps lock aligned without implicit padding.
+    mtx_t                     lock;     //< Class lock if concurrent.
+} cat_memory_slab_class_t;
+
+//! \struct cat_memory_pool_s
+//! \brief Managed memory pool; all allocator state lives here so pools are independent.
+typedef struct cat_memory_pool_s
+{
+    void*                           p_memory;                              //< Pool allocation.
+    size_t                          map_size;                              //< Size of mapping if pool is mapped; zero if heap block.
+    size_t                          size;                                  //< Usable pool size in bytes.
+    size_t                          used;                                  //< Bytes in use by general blocks, including headers.
+    uint32_t                        block_count;                           //< Number of live general blocks.
+    uint32_t                        flags;                                 //< Pool creation flags.
+    cat_memory_policy_t             policy;                                //< Free block search policy.
+    cat_memory_backend_t            backend;                               //< General block allocator.
+    size_t                          requested_total;                       //< Bytes requested by all general allocations.
+    size_t                          reserved_total;                        //< Bytes reserved by all general allocations.
+    struct cat_memory_block_s*      p_begin;                               //< First general block.
+    struct cat_memory_block_s*      p_end;                                 //< End of general blocks.
+    struct cat_memory_free_block_s* p_free_head;                           //< Head of general free list.
+    struct cat_memory_buddy_s*      p_buddy;                               //< Buddy allocator state if buddy backend.
+    struct cat_memory_slab_s*       p_slab_table;                          //< Slab descriptor table.
+    struct cat_memory_slab_s*       p_slab_free;                           //< Released slab pages.
+    uint8_t*                        p_slab_begin;                          //< First slab page.
+    uint8_t*                        p_slab_end;                            //< End of slab pages.
+    uint32_t                        slab_count;                            //< Number of slab pages.
+    uint32_t                        slab_bump;                             //< Number of slab pages ever used.
+    uint32_t                        slab_pages;                            //< Number of slab pages in use.
+    uint32_t                        reserved;                              //< Keeps peak aligned without implicit padding.
+    size_t                          peak;                                  //< Highest bytes in use by general blocks and slab pages.
+    uint32_t                        histogram[CAT_MEMORY_HISTOGRAM_BINS];  //< Live general blocks by log2 of reserved size.
+    cat_memory_slab_class_t         slab_class[CAT_MEMORY_SLAB_CLASSES];   //< Slab size classes.
+    mtx_t                           lock;                                  //< Lock for general blocks and slab pages if concurrent.
+    tss_t                           cache_key;                             //< Per-thread cache if concurrent.
+    uint32_t                        reserved_tail;                         //< Rounds size without implicit padding.
+} cat_memory_pool_t;
+
+//! \struct cat_memory_pool_stats_s
+//! \brief Memory pool usage snapshot.
+typedef struct cat_memory_pool_stats_s
+{
+    size_t   capacity;                            //< Bytes available to slab pages and general blocks.
+    size_t   in_use;                              //< Bytes in use by general blocks, including headers, and by slab pages.
+    size_t   peak;                                //< Highest \a in_use since pool was initialized.
+    size_t   largest_free;                        //< Largest free general extent in bytes.
+    double   fragmentation;                       //< Share of free general bytes outside largest free extent.
+    uint32_t live_blocks;                         //< Live general blocks and slab objects, including those held in thread caches.
+    uint32_t histogram[CAT_MEMORY_HISTOGRAM_BINS];//< Live blocks by log2 of size; slab objects count at class size.
+    uint32_t reserved;                            //< Rounds size without implicit padding.
+} cat_memory_pool_stats_t;
+
+//! \struct cat_memory_pool_snapshot_s
+//! \brief Saved memory pool contents and allocator state to restore pool to.
+typedef struct cat_memory_pool_snapshot_s
+{
+    cat_memory_pool_t const* p_pool;    //< Pool captured.
+    cat_memory_pool_t        state;     //< Allocator state at capture.
+    void*                    p_image;   //< Copy of slab range followed by general range; null if image is held in file.
+    size_t                   image_size;//< Bytes of pool memory captured.
+    size_t                   slab_size; //< Bytes of image from slab table through last slab page used.
+    int                      image_file;//< Memory file mapped copy-on-write over mapped pool on restore; -1 if none.
+    uint32_t                 reserved;  //< Rounds size without implicit padding.
+} cat_memory_pool_snapshot_t;
+
+//! \struct cat_memory_arena_s
+//! \brief Linear arena; blocks are bump-allocated and released all at once by rewind or reset.
+typedef struct cat_memory_arena_s
+{
+    cat_memory_pool_t* p_pool;  //< Pool backing arena; null if system heap.
+    uint8_t*           p_base;  //< Start of arena memory.
+    size_t             capacity;//< Size of arena memory in bytes.
+    size_t             offset;  //< Bytes in use from start of arena.
+} cat_memory_arena_t;
+
+//! \typedef cat_memory_arena_mark_t
+//! \brief Saved arena position to rewind to.
+typedef size_t cat_memory_arena_mark_t;
+
+//! \struct cat_memory_allocator_s
+//! \brief Generic allocator for containers; blocks are aligned for any fundamental type.
+typedef struct cat_memory_allocator_s
+{
+    cat_memory_allocator_kind_t kind;    //< Source of blocks.
+    uint32_t                    reserved;//< Must be zero.
+    void*                       p_source;//< Pool or arena; null if heap.
+} cat_memory_allocator_t;
+
+
+//! \fn cat_memory_simd_supported
+//! \brief Get widest instruction set for block kernels supported by processor and system.
+//! \return Supported instruction set.
+cat_decl cat_memory_simd_t cat_memory_simd_supported(void);
+
+//! \fn cat_memory_simd
+//! \brief Get instruction set used by block kernels; widest supported is selected on first use.
+//! \return Active instruction set.
+cat_decl cat_memory_simd_t cat_memory_simd(void);
+
+//! \fn cat_memory_set_simd
+//! \brief Select instruction set for block kernels, e.g. to compare kernels; call before other threads use kernels.
+//! \param simd Instruction set; must be supported.
+//! \return True if successful.
+cat_decl bool cat_memory_set_simd(cat_memory_simd_t const simd);
+
 //! \fn cat_memset
-//! \brief Set all bytes in block to a specified byte value.
+//! \brief Set all bytes in block to a specified byte value; large blocks bypass cache.
 //! \param p_block Pointer to block.
 //! \param value Byte value to assign to all bytes in block.
 //! \param set_size Number of bytes to set.
@@ -44,7 +230,7 @@ cat_decl void* cat_memset(void* const p_block, uint8_t const value, size_t const
 cat_decl void* cat_memclr(void* const p_block, size_t const clr_size);
 
 //! \fn cat_memcpy
-//! \brief Copy bytes from source block to destination block.
+//! \brief Copy bytes from source block to destination block; blocks must not overlap, large blocks bypass cache.
 //! \param p_block_dst Pointer to destination block.
 //! \param p_block_src Pointer to source block.
 //! \param cpy_size Number of bytes to copy.
@@ -59,55 +245,396 @@ cat_decl void* cat_memcpy(void* const p_block_dst, void const* const p_block_src
 //! \return True if blocks are equal.
 cat_decl bool cat_memcmp(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size);
 
+//! \fn cat_memory_compare
+//! \brief Compare bytes in memory blocks and locate first difference.
+//! \param p_block_lh Left-hand block.
+//! \param p_block_rh Right-hand block.
+//! \param cmp_size Number of bytes to compare.
+//! \param p_offset_out Optional pointer to store offset of first differing byte; \a cmp_size if blocks are equal.
+//! \return Negative, zero or positive as left-hand block orders before, equal to or after right-hand block.
+cat_decl int cat_memory_compare(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size, size_t* const p_offset_out);
+
+//! \fn cat_memory_hash
+//! \brief Compute 64-bit hash of block for checksums and digests; not cryptographic.
+//! Result depends only on bytes and seed, not on instruction set, so digests can be stored and compared across machines.
+//! \param p_block Pointer to block.
+//! \param hash_size Number of bytes to hash.
+//! \param seed Hash seed.
+//! \return Hash value.
+cat_decl uint64_t cat_memory_hash(void const* const p_block, size_t const hash_size, uint64_t const seed);
+
 //! \fn cat_malloc
-//! \brief Wrapper for standard malloc.
+//! \brief Wrapper for standard malloc; tracked with call site in debug build.
 //! \param block_size Size of block to allocate in bytes.
 //! \return Pointer to block.
-cat_decl void* cat_malloc(size_t const block_size);
+cat_decl void* (cat_malloc)(size_t const block_size);
 
 //! \fn cat_calloc
-//! \brief Wrapper for standard calloc.
+//! \brief Wrapper for standard calloc; tracked with call site in debug build.
 //! \param element_count Number of elements to allocate.
 //! \param element_size Size of single element in bytes.
 //! \return Pointer to block.
-cat_decl void* cat_calloc(size_t const element_count, size_t const element_size);
+cat_decl void* (cat_calloc)(size_t const element_count, size_t const element_size);
 
 //! \fn cat_realloc
-//! \brief Wrapper for standard realloc.
+//! \brief Wrapper for standard realloc; tracked with call site in debug build.
 //! \param p_block Pointer to block.
 //! \param block_size Size of block to allocate in bytes.
 //! \return Pointer to block.
-cat_decl void* cat_realloc(void* const p_block, size_t const block_size);
+cat_decl void* (cat_realloc)(void* const p_block, size_t const block_size);
 
 //! \fn cat_free
-//! \brief Wrapper for standard free.
+//! \brief Wrapper for standard free; in debug build, block must be tracked.
 //! \param p_block Pointer to block.
 cat_decl void cat_free(void* const p_block);
 
+//! \fn cat_malloc_report
+//! \brief Count blocks from \a cat_malloc, \a cat_calloc and \a cat_realloc that were not freed; always zero in release build.
+//! \param print Print call site, size and allocation number of each block.
+//! \return Number of live blocks.
+cat_decl size_t cat_malloc_report(bool const print);
+
+#ifdef CAT_DEBUG
+//! \fn cat_malloc_dbg
+//! \brief Debug malloc recording call site; called through \a cat_malloc macro.
+//! \param block_size Size of block to allocate in bytes.
+//! \param file Source file of call site.
+//! \param line Source line of call site.
+//! \return Pointer to block.
+cat_decl void* cat_malloc_dbg(size_t const block_size, char const* const file, uint32_t const line);
+
+//! \fn cat_calloc_dbg
+//! \brief Debug calloc recording call site; called through \a cat_calloc macro.
+//! \param element_count Number of elements to allocate.
+//! \param element_size Size of single element in bytes.
+//! \param file Source file of call site.
+//! \param line Source line of call site.
+//! \return Pointer to block.
+cat_decl void* cat_calloc_dbg(size_t const element_count, size_t const element_size, char const* const file, uint32_t const line);
+
+//! \fn cat_realloc_dbg
+//! \brief Debug realloc recording call site; called through \a cat_realloc macro.
+//! \param p_block Pointer to block.
+//! \param block_size Size of block to allocate in bytes.
+//! \param file Source file of call site.
+//! \param line Source line of call site.
+//! \return Pointer to block.
+cat_decl void* cat_realloc_dbg(void* const p_block, size_t const block_size, char const* const file, uint32_t const line);
+
+#define cat_malloc(block_size)                  cat_malloc_dbg(block_size, __FILE__, __LINE__)
+#define cat_calloc(element_count, element_size) cat_calloc_dbg(element_count, element_size, __FILE__, __LINE__)
+#define cat_realloc(p_block, block_size)        cat_realloc_dbg(p_block, block_size, __FILE__, __LINE__)
+#endif // #ifdef CAT_DEBUG
+
+//! \fn cat_memory_guard_enable
+//! \brief Place sampled blocks up to one page from \a cat_malloc family and \a cat_memory_alloc against inaccessible guard pages;
+//! access past either end or after release faults with report of allocation call site. Guarded block ends flush against
+//! following guard page, so it is aligned only to largest power of two dividing its size, up to 16 bytes.
+//! \param sample_rate Mean number of allocations per guarded one; zero for \a CAT_MEMORY_GUARD_SAMPLE_RATE.
+//! \param slot_count Maximum number of guarded blocks live at once, others are not sampled; zero for \a CAT_MEMORY_GUARD_SLOTS; ignored if already enabled.
+//! \return True if successful.
+cat_decl bool cat_memory_guard_enable(uint32_t const sample_rate, uint32_t const slot_count);
+
+//! \fn cat_memory_guard_disable
+//! \brief Stop sampling; guard pages are released once no guarded blocks are live.
+//! \return True if guard pages were released or never reserved.
+cat_decl bool cat_memory_guard_disable(void);
+
+//! \fn cat_memory_guard_owns
+//! \brief Check if block was placed against guard page.
+//! \param p_block Pointer to block.
+//! \return True if block is guarded.
+cat_decl bool cat_memory_guard_owns(void const* const p_block);
+
+//! \fn cat_memory_guard_sampled
+//! \brief Get number of blocks guarded since sampling was enabled.
+//! \return Number of guarded blocks.
+cat_decl uint32_t cat_memory_guard_sampled(void);
+
+//! \fn cat_malloc_aligned
+//! \brief Wrapper for platform aligned allocation.
+//! \param block_size Size of block to allocate in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two.
+//! \return Pointer to block; release with \a cat_free_aligned.
+cat_decl void* cat_malloc_aligned(size_t const block_size, size_t const block_align);
+
+//! \fn cat_free_aligned
+//! \brief Release block allocated with \a cat_malloc_aligned.
+//! \param p_block Pointer to block.
+cat_decl void cat_free_aligned(void* const p_block);
+
+//! \fn cat_memory_pool_init
+//! \brief Allocate and initialize memory pool instance; a quarter of the pool is reserved for small block slabs.
+//! \param p_pool Pointer to pool; must not already be initialized.
+//! \param pool_size Size of pool in bytes.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_init(cat_memory_pool_t* const p_pool, size_t const pool_size);
+
+//! \fn cat_memory_pool_init_desc
+//! \brief Allocate and initialize memory pool instance from descriptor.
+//! \param p_pool Pointer to pool; must not already be initialized.
+//! \param p_desc Pointer to pool descriptor.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_init_desc(cat_memory_pool_t* const p_pool, cat_memory_pool_desc_t const* const p_desc);
+
+//! \fn cat_memory_pool_term
+//! \brief Stop managing and deallocate memory pool instance; other threads using a concurrent pool must have exited.
+//! \param p_pool Pointer to pool.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_term(cat_memory_pool_t* const p_pool);
+
+//! \fn cat_memory_pool_flush
+//! \brief Return small blocks cached by calling thread to concurrent pool; caches are also flushed on thread exit.
+//! \param p_pool Pointer to pool.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_flush(cat_memory_pool_t* const p_pool);
+
+//! \fn cat_memory_pool_set_policy
+//! \brief Set free block search policy for memory pool instance.
+//! \param p_pool Pointer to pool.
+//! \param policy Search policy; first-fit is default.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_set_policy(cat_memory_pool_t* const p_pool, cat_memory_policy_t const policy);
+
+//! \fn cat_memory_pool_fragmentation
+//! \brief Measure fragmentation of general blocks in memory pool instance.
+//! \param p_pool Pointer to pool.
+//! \param p_internal_out Pointer to store internal fragmentation: share of reserved bytes not requested, over all allocations.
+//! \param p_external_out Pointer to store external fragmentation: share of free bytes outside largest free block.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_fragmentation(cat_memory_pool_t* const p_pool, double* const p_internal_out, double* const p_external_out);
+
+//! \fn cat_memory_pool_stats
+//! \brief Get usage snapshot of memory pool instance; counters are maintained on every allocation.
+//! \param p_pool Pointer to pool.
+//! \param p_stats_out Pointer to store statistics.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_stats(cat_memory_pool_t* const p_pool, cat_memory_pool_stats_t* const p_stats_out);
+
+//! \fn cat_memory_pool_snapshot
+//! \brief Capture contents and allocator state of memory pool instance, e.g. after building a test fixture; not for concurrent pools.
+//! \param p_pool Pointer to pool.
+//! \param p_snapshot_out Pointer to store snapshot; release with \a cat_memory_pool_snapshot_release.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_snapshot(cat_memory_pool_t* const p_pool, cat_memory_pool_snapshot_t* const p_snapshot_out);
+
+//! \fn cat_memory_pool_restore
+//! \brief Return memory pool instance to captured state; blocks allocated since capture are gone and captured blocks are back at same addresses.
+//! Usage counters are rewound too, so peak reported afterwards is peak at capture.
+//! \param p_pool Pointer to pool; must be pool snapshot was taken from.
+//! \param p_snapshot Pointer to snapshot; may be restored any number of times.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_restore(cat_memory_pool_t* const p_pool, cat_memory_pool_snapshot_t const* const p_snapshot);
+
+//! \fn cat_memory_pool_snapshot_release
+//! \brief Release memory held by snapshot; pool is unaffected.
+//! \param p_snapshot Pointer to snapshot.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_snapshot_release(cat_memory_pool_snapshot_t* const p_snapshot);
+
+//! \fn cat_memory_pool_alloc
+//! \brief Allocate block in memory pool instance; blocks up to 2048 bytes come from size class slabs, larger blocks split a free block.
+//! \param p_pool Pointer to pool.
+//! \param block_size Size of block allocation in bytes.
+//! \return Pointer to managed block if success; null if failed.
+cat_decl void* cat_memory_pool_alloc(cat_memory_pool_t* const p_pool, size_t const block_size);
+
+//! \fn cat_memory_pool_realloc
+//! \brief Resize block in memory pool instance; grows into free successor or buddy and shrinks by splitting in place, moves only if neither fits.
+//! Moved block has default alignment; resize blocks from \a cat_memory_pool_alloc_aligned with \a cat_memory_pool_realloc_aligned.
+//! \param p_pool Pointer to pool.
+//! \param p_block Pointer to block; null to allocate.
+//! \param block_size New size of block in bytes.
+//! \return Pointer to resized block, which may have moved; null if failed, in which case block is unchanged.
+cat_decl void* cat_memory_pool_realloc(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size);
+
+//! \fn cat_memory_pool_dealloc
+//! \brief Deallocate block in memory pool instance; coalesces with adjacent free blocks.
+//! \param p_pool Pointer to pool.
+//! \param p_block Pointer to managed block.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_dealloc(cat_memory_pool_t* const p_pool, void* const p_block);
+
+//! \fn cat_memory_pool_alloc_aligned
+//! \brief Allocate aligned block in memory pool instance; release with \a cat_memory_pool_dealloc.
+//! \param p_pool Pointer to pool.
+//! \param block_size Size of block allocation in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two.
+//! \return Pointer to managed block if success; null if failed.
+cat_decl void* cat_memory_pool_alloc_aligned(cat_memory_pool_t* const p_pool, size_t const block_size, size_t const block_align);
+
+//! \fn cat_memory_pool_realloc_aligned
+//! \brief Resize aligned block in memory pool instance as \a cat_memory_pool_realloc does, keeping alignment if block moves.
+//! \param p_pool Pointer to pool.
+//! \param p_block Pointer to block; null to allocate.
+//! \param block_size New size of block in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two and same as when allocated.
+//! \return Pointer to resized block, which may have moved; null if failed, in which case block is unchanged.
+cat_decl void* cat_memory_pool_realloc_aligned(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size, size_t const block_align);
+
 //! \fn cat_memory_pool_create
-//! \brief Allocate and initialize managed memory pool.
+//! \brief Allocate and initialize default managed memory pool.
 //! \param pool_size Size of pool in bytes.
 //! \return True if successful.
 cat_decl bool cat_memory_pool_create(size_t const pool_size);
 
+//! \fn cat_memory_pool_create_desc
+//! \brief Allocate and initialize default managed memory pool from descriptor.
+//! \param p_desc Pointer to pool descriptor.
+//! \return True if successful.
+cat_decl bool cat_memory_pool_create_desc(cat_memory_pool_desc_t const* const p_desc);
+
 //! \fn cat_memory_pool_destroy
-//! \brief Stop managing and deallocate memory pool.
-//! \param p_pool Pointer to pre-allocated pool.
+//! \brief Stop managing and deallocate default memory pool.
 //! \return True if successful.
 cat_decl bool cat_memory_pool_destroy(void);
 
+//! \fn cat_memory_set_policy
+//! \brief Set free block search policy for default memory pool.
+//! \param policy Search policy; first-fit is default.
+//! \return True if successful.
+cat_decl bool cat_memory_set_policy(cat_memory_policy_t const policy);
+
+//! \fn cat_memory_stats
+//! \brief Get usage snapshot of default memory pool.
+//! \param p_stats_out Pointer to store statistics.
+//! \return True if successful.
+cat_decl bool cat_memory_stats(cat_memory_pool_stats_t* const p_stats_out);
+
 //! \fn cat_memory_alloc
-//! \brief Allocate block in managed memory pool.
+//! \brief Allocate block in default memory pool.
 //! \param block_size Size of block allocation in bytes.
 //! \return Pointer to managed block if success; null if failed.
 cat_decl void* cat_memory_alloc(size_t const block_size);
 
+//! \fn cat_memory_alloc_aligned
+//! \brief Allocate aligned block in default memory pool; release with \a cat_memory_dealloc.
+//! \param block_size Size of block allocation in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two.
+//! \return Pointer to managed block if success; null if failed.
+cat_decl void* cat_memory_alloc_aligned(size_t const block_size, size_t const block_align);
+
+//! \fn cat_memory_realloc
+//! \brief Resize block in default memory pool; moves only if block cannot grow in place.
+//! Moved block has default alignment; resize blocks from \a cat_memory_alloc_aligned with \a cat_memory_realloc_aligned.
+//! \param p_block Pointer to block; null to allocate.
+//! \param block_size New size of block in bytes.
+//! \return Pointer to resized block, which may have moved; null if failed, in which case block is unchanged.
+cat_decl void* cat_memory_realloc(void* const p_block, size_t const block_size);
+
+//! \fn cat_memory_realloc_aligned
+//! \brief Resize aligned block in default memory pool, keeping alignment if block moves.
+//! \param p_block Pointer to block; null to allocate.
+//! \param block_size New size of block in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two and same as when allocated.
+//! \return Pointer to resized block, which may have moved; null if failed, in which case block is unchanged.
+cat_decl void* cat_memory_realloc_aligned(void* const p_block, size_t const block_size, size_t const block_align);
+
 //! \fn cat_memory_dealloc
-//! \brief Deallocate block in managed memory pool.
+//! \brief Deallocate block in default memory pool.
 //! \param p_block Pointer to managed block.
 //! \return True if successful.
 cat_decl bool cat_memory_dealloc(void* const p_block);
 
+//! \fn cat_memory_arena_init
+//! \brief Reserve arena memory from pool or system heap.
+//! \param p_arena Pointer to arena.
+//! \param p_pool Pointer to pool to reserve from; null for system heap.
+//! \param capacity Size of arena in bytes.
+//! \return True if successful.
+cat_decl bool cat_memory_arena_init(cat_memory_arena_t* const p_arena, cat_memory_pool_t* const p_pool, size_t const capacity);
+
+//! \fn cat_memory_arena_term
+//! \brief Release arena memory; all blocks from arena become invalid.
+//! \param p_arena Pointer to arena.
+//! \return True if successful.
+cat_decl bool cat_memory_arena_term(cat_memory_arena_t* const p_arena);
+
+//! \fn cat_memory_arena_alloc
+//! \brief Bump-allocate block from arena; blocks are never released individually.
+//! \param p_arena Pointer to arena.
+//! \param block_size Size of block allocation in bytes.
+//! \param block_align Alignment of block in bytes; must be power of two.
+//! \return Pointer to block if success; null if arena is full.
+cat_decl void* cat_memory_arena_alloc(cat_memory_arena_t* const p_arena, size_t const block_size, size_t const block_align);
+
+//! \fn cat_memory_arena_mark
+//! \brief Save current arena position.
+//! \param p_arena Pointer to arena.
+//! \return Mark to pass to \a cat_memory_arena_rewind.
+cat_decl cat_memory_arena_mark_t cat_memory_arena_mark(cat_memory_arena_t const* const p_arena);
+
+//! \fn cat_memory_arena_rewind
+//! \brief Release all blocks allocated since mark was saved.
+//! \param p_arena Pointer to arena.
+//! \param mark Mark saved by \a cat_memory_arena_mark.
+//! \return True if successful.
+cat_decl bool cat_memory_arena_rewind(cat_memory_arena_t* const p_arena, cat_memory_arena_mark_t const mark);
+
+//! \fn cat_memory_arena_reset
+//! \brief Release all blocks in arena.
+//! \param p_arena Pointer to arena.
+//! \return True if successful.
+cat_decl bool cat_memory_arena_reset(cat_memory_arena_t* const p_arena);
+
+//! \fn cat_memory_scratch_create
+//! \brief Create process-wide scratch arena for test temporaries; reset between tests by test driver.
+//! \param capacity Size of scratch arena in bytes.
+//! \return True if successful.
+cat_decl bool cat_memory_scratch_create(size_t const capacity);
+
+//! \fn cat_memory_scratch_destroy
+//! \brief Destroy process-wide scratch arena.
+//! \return True if successful.
+cat_decl bool cat_memory_scratch_destroy(void);
+
+//! \fn cat_memory_scratch
+//! \brief Get process-wide scratch arena; not shared between threads.
+//! \return Pointer to scratch arena; null if not created.
+cat_decl cat_memory_arena_t* cat_memory_scratch(void);
+
+
+//! \fn cat_memory_allocator_heap
+//! \brief Get allocator using system heap.
+//! \return Allocator.
+cat_decl cat_memory_allocator_t cat_memory_allocator_heap(void);
+
+//! \fn cat_memory_allocator_pool
+//! \brief Get allocator using memory pool instance.
+//! \param p_pool Pointer to pool; must outlive blocks.
+//! \return Allocator.
+cat_decl cat_memory_allocator_t cat_memory_allocator_pool(cat_memory_pool_t* const p_pool);
+
+//! \fn cat_memory_allocator_arena
+//! \brief Get allocator using arena.
+//! \param p_arena Pointer to arena; blocks are invalid after arena is rewound past them.
+//! \return Allocator.
+cat_decl cat_memory_allocator_t cat_memory_allocator_arena(cat_memory_arena_t* const p_arena);
+
+//! \fn cat_memory_allocator_alloc
+//! \brief Allocate block from allocator.
+//! \param p_allocator Pointer to allocator.
+//! \param block_size Size of block allocation in bytes.
+//! \return Pointer to block if success; null if failed.
+cat_decl void* cat_memory_allocator_alloc(cat_memory_allocator_t const* const p_allocator, size_t const block_size);
+
+//! \fn cat_memory_allocator_realloc
+//! \brief Resize block from allocator, in place where source allows.
+//! \param p_allocator Pointer to allocator.
+//! \param p_block Pointer to block; null to allocate.
+//! \param block_size_old Current size of block in bytes; arena needs it to find and copy block.
+//! \param block_size New size of block in bytes.
+//! \return Pointer to resized block, which may have moved; null if failed, in which case block is unchanged.
+cat_decl void* cat_memory_allocator_realloc(cat_memory_allocator_t const* const p_allocator, void* const p_block, size_t const block_size_old, size_t const block_size);
+
+//! \fn cat_memory_allocator_dealloc
+//! \brief Release block to allocator; arena only takes back its most recent block.
+//! \param p_allocator Pointer to allocator.
+//! \param p_block Pointer to block.
+//! \param block_size Size of block in bytes.
+//! \return True if successful.
+cat_decl bool cat_memory_allocator_dealloc(cat_memory_allocator_t const* const p_allocator, void* const p_block, size_t const block_size);
+
 
 cat_interface_end;
 
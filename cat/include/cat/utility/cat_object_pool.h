@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*! \file cat_object_pool.h
+*   \brief Generational object pool interface.
+*/
+
+#ifndef _CAT_OBJECT_POOL_H_
+#define _CAT_OBJECT_POOL_H_
+
+
+#include "cat/utility/cat_memory.h"
+
+
+cat_interface_begin;
+
+
+//! \def CAT_OBJECT_INDEX_BITS
+//! \brief Bits of handle holding slot index; remaining high bits hold generation.
+#define CAT_OBJECT_INDEX_BITS 20
+
+//! \def CAT_OBJECT_CAPACITY_MAX
+//! \brief Maximum number of objects in pool.
+#define CAT_OBJECT_CAPACITY_MAX ((uint32_t)1 << CAT_OBJECT_INDEX_BITS)
+
+//! \def CAT_OBJECT_HANDLE_NULL
+//! \brief Handle that never refers to an object.
+#define CAT_OBJECT_HANDLE_NULL ((cat_object_handle_t)0)
+
+//! \typedef cat_object_handle_t
+//! \brief Object handle: slot index in low bits, slot generation in high bits; stale once object is destroyed.
+typedef uint32_t cat_object_handle_t;
+
+//! \struct cat_object_slot_s
+//! \brief Handle slot; maps index to dense record while live, links free slots otherwise.
+typedef struct cat_object_slot_s
+{
+    uint32_t generation;//< Generation of current or next object; never zero.
+    uint32_t dense;     //< Dense index of record if live; next free slot otherwise.
+} cat_object_slot_t;
+
+//! \struct cat_object_pool_s
+//! \brief Fixed-capacity pool of same-sized records stored densely; records move when others are destroyed.
+typedef struct cat_object_pool_s
+{
+    cat_memory_pool_t*  p_pool;      //< Pool backing storage; null if system heap.
+    uint8_t*            p_data;      //< Dense records.
+    cat_object_slot_t*  p_slot;      //< Slot per handle index.
+    uint32_t*           p_owner;     //< Slot index per dense record.
+    size_t              object_size; //< Size of record in bytes.
+    uint32_t            capacity;    //< Maximum number of records.
+    uint32_t            count;       //< Number of live records.
+    uint32_t            slot_bump;   //< Number of slots ever used.
+    uint32_t            free_head;   //< First free slot; capacity if none.
+} cat_object_pool_t;
+
+
+//! \fn cat_object_pool_init
+//! \brief Initialize object pool with storage for all records.
+//! \param p_objects Pointer to object pool.
+//! \param p_pool Pointer to memory pool for storage; null to use system heap.
+//! \param object_size Size of record in bytes.
+//! \param capacity Maximum number of records, up to \a CAT_OBJECT_CAPACITY_MAX.
+//! \return True if successful.
+cat_decl bool cat_object_pool_init(cat_object_pool_t* const p_objects, cat_memory_pool_t* const p_pool, size_t const object_size, uint32_t const capacity);
+
+//! \fn cat_object_pool_term
+//! \brief Release object pool storage; all handles become stale.
+//! \param p_objects Pointer to object pool.
+//! \return True if successful.
+cat_decl bool cat_object_pool_term(cat_object_pool_t* const p_objects);
+
+//! \fn cat_object_pool_create
+//! \brief Create zeroed record.
+//! \param p_objects Pointer to object pool.
+//! \param p_handle_out Pointer to store handle of record.
+//! \return Pointer to record if success; null if pool is full.
+cat_decl void* cat_object_pool_create(cat_object_pool_t* const p_objects, cat_object_handle_t* const p_handle_out);
+
+//! \fn cat_object_pool_destroy
+//! \brief Destroy record; last record moves into its place so pointers from \a cat_object_pool_get must be fetched again.
+//! \param p_objects Pointer to object pool.
+//! \param handle Handle of record.
+//! \return True if successful; false if handle is stale.
+cat_decl bool cat_object_pool_destroy(cat_object_pool_t* const p_objects, cat_object_handle_t const handle);
+
+//! \fn cat_object_pool_get
+//! \brief Look up record by handle.
+//! \param p_objects Pointer to object pool.
+//! \param handle Handle of record.
+//! \return Pointer to record if handle is live; null if stale.
+cat_decl void* cat_object_pool_get(cat_object_pool_t const* const p_objects, cat_object_handle_t const handle);
+
+//! \fn cat_object_pool_at
+//! \brief Get record by dense position for iteration over all live records.
+//! \param p_objects Pointer to object pool.
+//! \param dense Position in 0 up to record count.
+//! \param p_handle_out Optional pointer to store handle of record.
+//! \return Pointer to record.
+cat_decl void* cat_object_pool_at(cat_object_pool_t const* const p_objects, uint32_t const dense, cat_object_handle_t* const p_handle_out);
+
+
+cat_interface_end;
+
+
+#endif // #ifndef _CAT_OBJECT_POOL_H_
\ No newline at end of file
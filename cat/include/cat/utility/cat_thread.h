@@ -22,7 +22,8 @@
 #define _CAT_THREAD_H_
 
 
-#include "cat/cat_platform.h"
+#include "cat/utility/cat_memory.h"
+#include "cat/utility/cat_time.h"
 #include <threads.h>
 
 cat_interface_begin;
@@ -41,15 +42,51 @@ typedef struct cat_thread_params_s
     void* const*      argv;//< Function argument vector.
 } cat_thread_params_t;
 
-#define MAX_THREADS 5
+//! \def CAT_THREAD_CPU_MAX
+//! \brief Number of logical processors that sets and topology can describe.
+#define CAT_THREAD_CPU_MAX 256
 
-typedef struct cat_thread_manager_s
+//! \struct cat_thread_cpuset_s
+//! \brief Set of logical processors; processor n is bit n % 64 of word n / 64 (on Windows n is group times 64 plus number in group).
+typedef struct cat_thread_cpuset_s
 {
-    thrd_t* active[MAX_THREADS];
-    thrd_t* inactive[MAX_THREADS];
-    int results[MAX_THREADS];
-    int num_threads;
-} cat_thread_manager_t;
+    uint64_t bits[CAT_THREAD_CPU_MAX / 64];//< Processor bits.
+} cat_thread_cpuset_t;
+
+//! \struct cat_thread_topology_s
+//! \brief Layout of logical processors available to process.
+typedef struct cat_thread_topology_s
+{
+    cat_thread_cpuset_t available;                //< Processors process may run on.
+    uint16_t            node[CAT_THREAD_CPU_MAX]; //< NUMA node of each processor.
+    uint16_t            core[CAT_THREAD_CPU_MAX]; //< Physical core of each processor; hyperthreads share core, numbered across all nodes.
+    size_t              num_cpus;                 //< Number of available processors.
+    size_t              num_nodes;                //< Number of NUMA nodes; one if not NUMA.
+} cat_thread_topology_t;
+
+//! \enum cat_thread_placement_e
+//! \brief Placement of thread manager workers on processors.
+typedef enum cat_thread_placement_e
+{
+    cat_thread_placement_none,   // Workers float wherever system schedules them.
+    cat_thread_placement_compact,// Worker per processor, filling hyperthreads of core, then cores of node, then next node.
+    cat_thread_placement_scatter,// Worker per processor, spreading over nodes first, then cores, then hyperthreads.
+    cat_thread_placement_node,   // Worker may run on any processor of its node; nodes taken in turn, one worker per node by default.
+} cat_thread_placement_t;
+
+//! \def CAT_THREAD_NAME_MAX
+//! \brief Size of thread name storage including terminator; longer names are truncated, as Linux allows only 15 characters.
+#define CAT_THREAD_NAME_MAX 16
+
+//! \struct cat_thread_info_s
+//! \brief Snapshot of live thread started by cat thread functions or thread manager.
+typedef struct cat_thread_info_s
+{
+    char       name[CAT_THREAD_NAME_MAX];//< Name given by rename, truncated; empty if never renamed.
+    uint64_t   tid;                      //< Operating system thread id.
+    cat_time_t time_created;             //< Platform time when thread started, in ticks.
+    uint64_t   time_cpu_ns;              //< CPU time consumed so far, in nanoseconds.
+} cat_thread_info_t;
 
 //! \fn cat_thrd_create
 //! \brief Create a new thread with parameter list.
@@ -58,18 +95,446 @@ typedef struct cat_thread_manager_s
 //! \return Thread handle; zero if failed.
 cat_decl int cat_thrd_create(thrd_t* const p_thread_out, cat_thread_params_t const* const p_thread_params);
 
-cat_decl void cat_mngr_create(cat_thread_manager_t* p_thread_manager_out);
+//! \fn cat_thread_rename
+//! \brief Rename current thread as seen by debugger and system tools, and in thread registry.
+//! \param name Name c-string; truncated to CAT_THREAD_NAME_MAX - 1 characters on Linux and in registry.
+//! \return True if success.
+cat_decl bool cat_thread_rename(cstr_t const name);
+
+//! \fn cat_thread_registry_query
+//! \brief Snapshot live threads started by cat thread functions or thread manager, in start order; safe while threads run.
+//! \param p_info_out Pointer to storage for thread info; may be null to count only.
+//! \param capacity Number of elements in storage.
+//! \return Number of live threads, which may exceed capacity.
+cat_decl size_t cat_thread_registry_query(cat_thread_info_t* const p_info_out, size_t const capacity);
 
-cat_decl int cat_mngr_activate_thread(cat_thread_manager_t* p_thread_manager, cat_thread_params_t const* const p_thread_params);
+//! \fn cat_thrd_create_pinned
+//! \brief Create a new thread with parameter list that runs only on given processors from its start.
+//! \param p_thread_out Pointer to result standard thread.
+//! \param p_thread_params Pointer to thread parameters container; copied.
+//! \param p_cpuset Pointer to processor set.
+//! \return thrd_success if created.
+cat_decl int cat_thrd_create_pinned(thrd_t* const p_thread_out, cat_thread_params_t const* const p_thread_params, cat_thread_cpuset_t const* const p_cpuset);
 
-cat_decl void cat_mngr_join_all_threads(cat_thread_manager_t* p_thread_manager);
+//! \fn cat_thread_affinity_set
+//! \brief Restrict current thread to set of processors; on Windows only processors in first group of set are used.
+//! \param p_cpuset Pointer to processor set.
+//! \return True if success.
+cat_decl bool cat_thread_affinity_set(cat_thread_cpuset_t const* const p_cpuset);
 
-//! \fn cat_thread_rename
-//! \brief Rename current thread.
-//! \param name Name c-string.
+//! \fn cat_thread_affinity_get
+//! \brief Get set of processors current thread may run on.
+//! \param p_cpuset_out Pointer to storage for processor set.
 //! \return True if success.
-cat_decl bool cat_thread_rename(cstr_t const name);
+cat_decl bool cat_thread_affinity_get(cat_thread_cpuset_t* const p_cpuset_out);
+
+//! \fn cat_thread_topology
+//! \brief Describe processors and NUMA nodes available to process.
+//! \param p_topology_out Pointer to storage for topology.
+//! \return True if success.
+cat_decl bool cat_thread_topology(cat_thread_topology_t* const p_topology_out);
+
+//! \fn cat_thread_current_node
+//! \brief Get NUMA node of processor current thread is running on; stable only while thread is pinned within node.
+//! \return Node index; zero if not NUMA or unknown.
+cat_decl size_t cat_thread_current_node(void);
+
+//! \fn cat_thread_cpuset_add
+//! \brief Add processor to set.
+//! \param p_cpuset Pointer to processor set.
+//! \param cpu Processor index.
+//! \return True if index fits in set.
+cat_decl bool cat_thread_cpuset_add(cat_thread_cpuset_t* const p_cpuset, size_t const cpu);
+
+//! \fn cat_thread_cpuset_has
+//! \brief Check whether processor is in set.
+//! \param p_cpuset Pointer to processor set.
+//! \param cpu Processor index.
+//! \return True if processor is in set.
+cat_decl bool cat_thread_cpuset_has(cat_thread_cpuset_t const* const p_cpuset, size_t const cpu);
+
+
+//! \def CAT_THREAD_CACHE_LINE
+//! \brief Assumed cache line size; index groups written by different threads each start on own line of this size.
+#define CAT_THREAD_CACHE_LINE 64
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4324 4820)// padding from alignment specifier is intended
+#endif // #ifdef _WIN32
+
+//! \struct cat_thread_spsc_s
+//! \brief Bounded single-producer single-consumer ring of same-sized elements; wait-free, each side writes only its own index
+//! and keeps a stale copy of the other so it touches the other side's cache line only when the ring looks full or empty.
+//! Type is cache-line aligned; place on heap with \a cat_malloc_aligned.
+typedef struct cat_thread_spsc_s
+{
+    cat_memory_allocator_t allocator;   //< Source of storage.
+    uint8_t*               p_data;      //< Elements.
+    size_t                 element_size;//< Size of element in bytes.
+    size_t                 mask;        //< Capacity minus one; capacity is power of two.
+    _Alignas(CAT_THREAD_CACHE_LINE)
+    size_t volatile        head;        //< Count of elements ever enqueued; written by producer; starts producer line.
+    size_t                 tail_cached; //< Producer's copy of tail.
+    _Alignas(CAT_THREAD_CACHE_LINE)
+    size_t volatile        tail;        //< Count of elements ever dequeued; written by consumer; starts consumer line.
+    size_t                 head_cached; //< Consumer's copy of head.
+} cat_thread_spsc_t;
+
+//! \struct cat_thread_mpmc_s
+//! \brief Bounded multi-producer multi-consumer ring of same-sized elements (Vyukov); each cell carries sequence number
+//! telling whether it is ready for the producer or consumer of a given position, so sides only contend on their own index.
+//! Type is cache-line aligned; place on heap with \a cat_malloc_aligned.
+typedef struct cat_thread_mpmc_s
+{
+    cat_memory_allocator_t allocator;   //< Source of storage.
+    uint8_t*               p_cell;      //< Cells; element follows sequence number in each.
+    size_t                 element_size;//< Size of element in bytes.
+    size_t                 cell_size;   //< Size of cell in bytes, rounded for alignment.
+    size_t                 mask;        //< Capacity minus one; capacity is power of two.
+    _Alignas(CAT_THREAD_CACHE_LINE)
+    size_t volatile        head;        //< Next position to enqueue; claimed by producers; starts producer line.
+    _Alignas(CAT_THREAD_CACHE_LINE)
+    size_t volatile        tail;        //< Next position to dequeue; claimed by consumers; starts consumer line.
+} cat_thread_mpmc_t;
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif // #ifdef _WIN32
+
+
+//! \fn cat_thread_spsc_init
+//! \brief Initialize single-producer single-consumer ring.
+//! \param p_ring Pointer to ring.
+//! \param p_allocator Pointer to allocator, copied into ring; null for system heap.
+//! \param element_size Size of element in bytes.
+//! \param capacity Number of elements held at once; rounded up to power of two.
+//! \return True if successful.
+cat_decl bool cat_thread_spsc_init(cat_thread_spsc_t* const p_ring, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity);
+
+//! \fn cat_thread_spsc_term
+//! \brief Release ring storage; no thread may be using ring.
+//! \param p_ring Pointer to ring.
+//! \return True if successful.
+cat_decl bool cat_thread_spsc_term(cat_thread_spsc_t* const p_ring);
+
+//! \fn cat_thread_spsc_enqueue
+//! \brief Copy element into ring; producer thread only.
+//! \param p_ring Pointer to ring.
+//! \param p_element Pointer to element.
+//! \return True if enqueued; false if full.
+cat_decl bool cat_thread_spsc_enqueue(cat_thread_spsc_t* const p_ring, void const* const p_element);
+
+//! \fn cat_thread_spsc_dequeue
+//! \brief Copy oldest element out of ring; consumer thread only.
+//! \param p_ring Pointer to ring.
+//! \param p_element_out Pointer to storage for element.
+//! \return True if dequeued; false if empty.
+cat_decl bool cat_thread_spsc_dequeue(cat_thread_spsc_t* const p_ring, void* const p_element_out);
+
+//! \fn cat_thread_spsc_enqueue_batch
+//! \brief Copy as many consecutive elements as fit into ring, published at once; producer thread only.
+//! \param p_ring Pointer to ring.
+//! \param p_elements Pointer to elements.
+//! \param count Number of elements.
+//! \return Number of elements enqueued.
+cat_decl size_t cat_thread_spsc_enqueue_batch(cat_thread_spsc_t* const p_ring, void const* const p_elements, size_t const count);
+
+//! \fn cat_thread_spsc_dequeue_batch
+//! \brief Copy up to count oldest elements out of ring, released at once; consumer thread only.
+//! \param p_ring Pointer to ring.
+//! \param p_elements_out Pointer to storage for elements.
+//! \param count Maximum number of elements.
+//! \return Number of elements dequeued.
+cat_decl size_t cat_thread_spsc_dequeue_batch(cat_thread_spsc_t* const p_ring, void* const p_elements_out, size_t const count);
+
+//! \fn cat_thread_mpmc_init
+//! \brief Initialize multi-producer multi-consumer ring.
+//! \param p_ring Pointer to ring.
+//! \param p_allocator Pointer to allocator, copied into ring; null for system heap.
+//! \param element_size Size of element in bytes.
+//! \param capacity Number of elements held at once; rounded up to power of two, at least two.
+//! \return True if successful.
+cat_decl bool cat_thread_mpmc_init(cat_thread_mpmc_t* const p_ring, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity);
+
+//! \fn cat_thread_mpmc_term
+//! \brief Release ring storage; no thread may be using ring.
+//! \param p_ring Pointer to ring.
+//! \return True if successful.
+cat_decl bool cat_thread_mpmc_term(cat_thread_mpmc_t* const p_ring);
+
+//! \fn cat_thread_mpmc_enqueue
+//! \brief Copy element into ring; any thread.
+//! \param p_ring Pointer to ring.
+//! \param p_element Pointer to element.
+//! \return True if enqueued; false if full.
+cat_decl bool cat_thread_mpmc_enqueue(cat_thread_mpmc_t* const p_ring, void const* const p_element);
+
+//! \fn cat_thread_mpmc_dequeue
+//! \brief Copy oldest element out of ring; any thread.
+//! \param p_ring Pointer to ring.
+//! \param p_element_out Pointer to storage for element.
+//! \return True if dequeued; false if empty.
+cat_decl bool cat_thread_mpmc_dequeue(cat_thread_mpmc_t* const p_ring, void* const p_element_out);
+
+//! \fn cat_thread_mpmc_enqueue_batch
+//! \brief Claim run of free cells with one update of head and copy elements into them; any thread.
+//! \param p_ring Pointer to ring.
+//! \param p_elements Pointer to elements.
+//! \param count Number of elements.
+//! \return Number of elements enqueued, in order from first.
+cat_decl size_t cat_thread_mpmc_enqueue_batch(cat_thread_mpmc_t* const p_ring, void const* const p_elements, size_t const count);
+
+//! \fn cat_thread_mpmc_dequeue_batch
+//! \brief Claim run of ready cells with one update of tail and copy elements out of them; any thread.
+//! \param p_ring Pointer to ring.
+//! \param p_elements_out Pointer to storage for elements.
+//! \param count Maximum number of elements.
+//! \return Number of elements dequeued.
+cat_decl size_t cat_thread_mpmc_dequeue_batch(cat_thread_mpmc_t* const p_ring, void* const p_elements_out, size_t const count);
+
+
+//! \def CAT_THREAD_QUEUE_CAPACITY
+//! \brief Number of tasks held in thread manager queue; when full, submitting thread runs queued tasks itself.
+#define CAT_THREAD_QUEUE_CAPACITY 4096
+
+//! \def CAT_THREAD_DEQUE_CAPACITY
+//! \brief Number of tasks held in each worker's deque; when full, spawned tasks go to shared queue.
+#define CAT_THREAD_DEQUE_CAPACITY 1024
+
+//! \def CAT_THREAD_SPIN_COUNT
+//! \brief Number of empty polls for work before idle worker parks.
+#define CAT_THREAD_SPIN_COUNT 4096
+
+//! \struct cat_thread_group_s
+//! \brief Completion counter shared by related tasks, e.g. children of divide-and-conquer step.
+typedef struct cat_thread_group_s
+{
+    size_t volatile pending;//< Number of tasks spawned into group and not finished.
+    size_t volatile failed; //< Number of tasks returning nonzero since last sync.
+} cat_thread_group_t;
+
+//! \def CAT_THREAD_INFINITE
+//! \brief Timeout that never expires.
+#define CAT_THREAD_INFINITE UINT32_MAX
+
+//! \struct cat_thread_completion_s
+//! \brief Completion handle of one submitted task, owned by caller; must stay valid until task and its continuations have finished.
+typedef struct cat_thread_completion_s
+{
+    cat_thread_params_t                      params;        //< Task submitted when antecedent finishes, if continuation.
+    struct cat_thread_completion_s*          p_next;        //< Next continuation of same antecedent.
+    struct cat_thread_completion_s* volatile p_continuation;//< First continuation waiting on task; closed marker once finished; accessed atomically only.
+    size_t volatile                          finished;      //< Nonzero once task has finished and result is set.
+    int                                      result;        //< Task return value.
+    uint32_t                                 reserved;      //< Rounds size without implicit padding.
+} cat_thread_completion_t;
+
+//! \struct cat_thread_task_s
+//! \brief Queued task.
+typedef struct cat_thread_task_s
+{
+    cat_thread_params_t      params;      //< Task function and arguments.
+    cat_thread_group_t*      p_group;     //< Group notified when task finishes.
+    cat_thread_completion_t* p_completion;//< Completion handle set when task finishes; may be null.
+} cat_thread_task_t;
+
+//! \struct cat_thread_worker_s
+//! \brief Worker thread owning Chase-Lev deque; owner pushes and pops newest tasks at bottom, thieves take oldest at top.
+typedef struct cat_thread_worker_s
+{
+    cat_thread_task_t*            p_task;   //< Deque storage.
+    size_t                        mask;     //< Deque capacity minus one; capacity is power of two.
+    struct cat_thread_manager_s*  p_manager;//< Owning manager.
+    thrd_t                        thread;   //< Worker thread.
+    uint64_t                      seed;     //< State for picking victims.
+    size_t                        steals;   //< Number of tasks taken from other workers.
+    cat_thread_cpuset_t           cpuset;   //< Processors worker is pinned to; empty if floating.
+    size_t                        node;     //< NUMA node of pinned processors.
+    uint8_t                       pad_owner[CAT_THREAD_CACHE_LINE];//< Keeps owner fields off top line.
+    size_t volatile               top;      //< Position of oldest task; advanced by thieves and by owner taking last task.
+    uint8_t                       pad_top[CAT_THREAD_CACHE_LINE - sizeof(size_t)];//< Keeps top line off bottom line.
+    size_t volatile               bottom;   //< Position after newest task; written by owner.
+    uint8_t                       pad_bottom[CAT_THREAD_CACHE_LINE - sizeof(size_t)];//< Keeps bottom line off next worker.
+} cat_thread_worker_t;
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4324 4820)// padding from aligned queue is intended
+#endif // #ifdef _WIN32
+
+//! \struct cat_thread_manager_s
+//! \brief Persistent pool of work-stealing worker threads; tasks submitted from outside go to shared queue, tasks spawned
+//! by running task go to its worker's deque, and workers out of work steal from random others before spinning briefly
+//! and parking on condition variable; submitting only signals when some worker is parked.
+typedef struct cat_thread_manager_s
+{
+    cat_thread_mpmc_t      queue;      //< Tasks submitted from outside workers.
+    cat_thread_worker_t*   p_worker;   //< Workers.
+    size_t                 num_threads;//< Number of worker threads.
+    cat_thread_placement_t placement;  //< Placement of workers on processors.
+    uint32_t               reserved;   //< Keeps group aligned without implicit padding.
+    cat_thread_group_t     group;      //< Group of tasks submitted without one.
+    size_t volatile        sleeping;   //< Number of workers parked on wake.
+    size_t volatile        running;    //< Nonzero until manager is destroyed.
+    mtx_t                  lock;       //< Lock for parking and joining.
+    cnd_t                  wake;       //< Signaled when task submitted while workers parked.
+    cnd_t                  idle;       //< Signaled when manager's group finishes.
+    size_t volatile        waiting;    //< Number of threads parked on done.
+    cnd_t                  done;       //< Signaled when task with completion handle finishes while threads parked.
+} cat_thread_manager_t;
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif // #ifdef _WIN32
+
+
+//! \fn cat_thread_hardware_concurrency
+//! \brief Get number of logical processors available to process.
+//! \return Number of logical processors; at least one.
+cat_decl size_t cat_thread_hardware_concurrency(void);
+
+//! \fn cat_mngr_create
+//! \brief Create thread manager and start its workers; manager must not move until destroyed.
+//! \param p_thread_manager_out Pointer to manager.
+//! \param num_threads Number of worker threads; zero for hardware concurrency, or number of nodes with node placement.
+//! \param placement Placement of workers on processors; workers beyond number of processors or nodes wrap around.
+//! \return True if successful.
+cat_decl bool cat_mngr_create(cat_thread_manager_t* const p_thread_manager_out, size_t const num_threads, cat_thread_placement_t const placement);
+
+//! \fn cat_mngr_destroy
+//! \brief Finish submitted tasks, stop workers and release manager.
+//! \param p_thread_manager Pointer to manager.
+//! \return True if successful.
+cat_decl bool cat_mngr_destroy(cat_thread_manager_t* const p_thread_manager);
+
+//! \fn cat_mngr_activate_thread
+//! \brief Submit task into manager's own group; parameters are copied, arguments must stay valid until task finishes.
+//! \param p_thread_manager Pointer to manager.
+//! \param p_thread_params Pointer to task parameters container.
+//! \param p_completion_out Pointer to completion handle to track task; may be null.
+//! \return thrd_success if submitted; thrd_error otherwise.
+cat_decl int cat_mngr_activate_thread(cat_thread_manager_t* const p_thread_manager, cat_thread_params_t const* const p_thread_params, cat_thread_completion_t* const p_completion_out);
+
+//! \fn cat_mngr_then
+//! \brief Submit task into manager's own group once antecedent task finishes; submitted at once if already finished.
+//! \param p_thread_manager Pointer to manager.
+//! \param p_completion Pointer to completion handle of antecedent.
+//! \param p_thread_params Pointer to continuation parameters container.
+//! \param p_completion_out Pointer to completion handle to track continuation; required since it holds continuation until submitted.
+//! \return thrd_success if chained; thrd_error otherwise.
+cat_decl int cat_mngr_then(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t* const p_completion, cat_thread_params_t const* const p_thread_params, cat_thread_completion_t* const p_completion_out);
+
+//! \fn cat_mngr_poll
+//! \brief Check whether task has finished without waiting.
+//! \param p_completion Pointer to completion handle.
+//! \param p_result_out Pointer to storage for task return value if finished; may be null.
+//! \return True if finished.
+cat_decl bool cat_mngr_poll(cat_thread_completion_t const* const p_completion, int* const p_result_out);
+
+//! \fn cat_mngr_wait
+//! \brief Wait for task to finish; manager's workers run other tasks meanwhile instead of blocking.
+//! \param p_thread_manager Pointer to manager.
+//! \param p_completion Pointer to completion handle.
+//! \param timeout_ms Timeout in milliseconds; CAT_THREAD_INFINITE to wait until finished.
+//! \param p_result_out Pointer to storage for task return value if finished; may be null.
+//! \return thrd_success if finished; thrd_timedout if timeout expired; thrd_error otherwise.
+cat_decl int cat_mngr_wait(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const p_completion, uint32_t const timeout_ms, int* const p_result_out);
+
+//! \fn cat_mngr_wait_any
+//! \brief Wait for first of several tasks to finish.
+//! \param p_thread_manager Pointer to manager.
+//! \param pp_completion Array of pointers to completion handles.
+//! \param count Number of handles.
+//! \param timeout_ms Timeout in milliseconds; CAT_THREAD_INFINITE to wait until one finished.
+//! \param p_index_out Pointer to storage for index of lowest finished handle; may be null.
+//! \return thrd_success if one finished; thrd_timedout if timeout expired; thrd_error otherwise.
+cat_decl int cat_mngr_wait_any(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const* const pp_completion, size_t const count, uint32_t const timeout_ms, size_t* const p_index_out);
+
+//! \fn cat_mngr_wait_all
+//! \brief Wait for every one of several tasks to finish.
+//! \param p_thread_manager Pointer to manager.
+//! \param pp_completion Array of pointers to completion handles.
+//! \param count Number of handles.
+//! \param timeout_ms Timeout in milliseconds; CAT_THREAD_INFINITE to wait until all finished.
+//! \return thrd_success if all finished; thrd_timedout if timeout expired; thrd_error otherwise.
+cat_decl int cat_mngr_wait_all(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const* const pp_completion, size_t const count, uint32_t const timeout_ms);
+
+//! \fn cat_mngr_spawn
+//! \brief Submit task into group; from task running on this manager's worker, task goes to that worker's deque.
+//! \param p_thread_manager Pointer to manager.
+//! \param p_thread_params Pointer to task parameters container; copied, arguments must stay valid until task finishes.
+//! \param p_group Pointer to group counting task; must stay valid until synchronized.
+//! \return thrd_success if submitted; thrd_error otherwise.
+cat_decl int cat_mngr_spawn(cat_thread_manager_t* const p_thread_manager, cat_thread_params_t const* const p_thread_params, cat_thread_group_t* const p_group);
+
+//! \fn cat_mngr_sync
+//! \brief Wait until every task in group has finished, running other tasks meanwhile so workers never block on children.
+//! \param p_thread_manager Pointer to manager.
+//! \param p_group Pointer to group.
+//! \return thrd_success if every task in group since last sync returned zero; thrd_error otherwise.
+cat_decl int cat_mngr_sync(cat_thread_manager_t* const p_thread_manager, cat_thread_group_t* const p_group);
+
+//! \fn cat_mngr_join_all_threads
+//! \brief Wait until every submitted task has finished, running queued tasks on calling thread meanwhile; workers stay alive.
+//! \param p_thread_manager Pointer to manager.
+//! \return thrd_success if every task since last join returned zero; thrd_error otherwise.
+cat_decl int cat_mngr_join_all_threads(cat_thread_manager_t* const p_thread_manager);
+
+
+
+//! \def CAT_PARALLEL_SPLITS_PER_WORKER
+//! \brief With automatic grain, range is first split into about this power of two many chunks per worker.
+#define CAT_PARALLEL_SPLITS_PER_WORKER 3
+
+//! \def CAT_PARALLEL_STEAL_SPLITS
+//! \brief With automatic grain, number of further halvings allowed to chunk that was stolen by idle worker.
+#define CAT_PARALLEL_STEAL_SPLITS 2
+
+//! \def CAT_PARALLEL_VALUE_SIZE
+//! \brief Reduction values up to this size are kept on stack while halves are combined; larger ones are allocated.
+#define CAT_PARALLEL_VALUE_SIZE 64
+
+//! \typedef cat_parallel_for_func_t
+//! \brief Loop body over index range [begin, end).
+typedef void(*cat_parallel_for_func_t)(size_t const begin, size_t const end, void* const p_ctx);
+
+//! \typedef cat_parallel_reduce_func_t
+//! \brief Loop body over index range [begin, end) accumulating into value, which starts as identity.
+typedef void(*cat_parallel_reduce_func_t)(size_t const begin, size_t const end, void* const p_ctx, void* const p_value);
+
+//! \typedef cat_parallel_combine_func_t
+//! \brief Fold value of right range into value of adjacent left range; must be associative, need not be commutative.
+typedef void(*cat_parallel_combine_func_t)(void* const p_value_lh, void const* const p_value_rh, void* const p_ctx);
+
+
+//! \fn cat_parallel_for
+//! \brief Run loop body over index range on manager's workers and calling thread, halving range into stolen chunks.
+//! \param p_thread_manager Pointer to manager.
+//! \param begin First index.
+//! \param end One past last index.
+//! \param grain Largest chunk passed to body; zero to adapt chunk count to workers and to stealing.
+//! \param func Loop body.
+//! \param p_ctx Context passed to body.
+//! \return True if successful.
+cat_decl bool cat_parallel_for(cat_thread_manager_t* const p_thread_manager, size_t const begin, size_t const end, size_t const grain,
+    cat_parallel_for_func_t const func, void* const p_ctx);
 
+//! \fn cat_parallel_reduce
+//! \brief Run reducing loop body over index range like cat_parallel_for, combining chunk values in index order.
+//! \param p_thread_manager Pointer to manager.
+//! \param begin First index.
+//! \param end One past last index.
+//! \param grain Largest chunk passed to body; zero to adapt chunk count to workers and to stealing.
+//! \param func Loop body.
+//! \param combine Value combine function.
+//! \param p_ctx Context passed to body and combine function.
+//! \param p_identity Pointer to value each chunk starts from.
+//! \param value_size Size of value in bytes.
+//! \param p_value_out Pointer to storage for result; identity if range is empty.
+//! \return True if successful.
+cat_decl bool cat_parallel_reduce(cat_thread_manager_t* const p_thread_manager, size_t const begin, size_t const end, size_t const grain,
+    cat_parallel_reduce_func_t const func, cat_parallel_combine_func_t const combine, void* const p_ctx, void const* const p_identity, size_t const value_size, void* const p_value_out);
 
 cat_interface_end;
 
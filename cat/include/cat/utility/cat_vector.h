@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*! \file cat_vector.h
+*   \brief Dynamic array interface.
+*/
+
+#ifndef _CAT_VECTOR_H_
+#define _CAT_VECTOR_H_
+
+
+#include "cat/utility/cat_memory.h"
+
+
+cat_interface_begin;
+
+
+//! \def CAT_VECTOR_CAPACITY_MIN
+//! \brief Smallest capacity reserved by first growth.
+#define CAT_VECTOR_CAPACITY_MIN 8
+
+//! \struct cat_vector_s
+//! \brief Dynamic array of same-sized elements; storage grows by half again when full so appends are amortized constant time.
+typedef struct cat_vector_s
+{
+    cat_memory_allocator_t allocator;   //< Source of storage.
+    uint8_t*               p_data;      //< Elements; null if no storage reserved.
+    size_t                 element_size;//< Size of element in bytes.
+    size_t                 count;       //< Number of elements.
+    size_t                 capacity;    //< Number of elements storage holds.
+} cat_vector_t;
+
+
+//! \def cat_vector_init_of
+//! \brief Initialize vector of type.
+//! \param type Element type.
+//! \param p_vector Pointer to vector.
+//! \param p_allocator Pointer to allocator; null for system heap.
+//! \param capacity Number of elements to reserve.
+#define cat_vector_init_of(type, p_vector, p_allocator, capacity) cat_vector_init(p_vector, p_allocator, sizeof(type), capacity)
+
+//! \def cat_vector_of
+//! \brief Get elements of vector as type; null if element size does not match type.
+//! \param type Element type.
+//! \param p_vector Pointer to vector.
+#define cat_vector_of(type, p_vector)                             ((type*)cat_vector_data(cat_vector_check(p_vector, sizeof(type))))
+
+//! \def cat_vector_at_of
+//! \brief Get element of vector as type; null if element size does not match type or index is out of range.
+//! \param type Element type.
+//! \param p_vector Pointer to vector.
+//! \param index Index of element.
+#define cat_vector_at_of(type, p_vector, index)                   ((type*)cat_vector_at(cat_vector_check(p_vector, sizeof(type)), index))
+
+//! \def cat_vector_push_of
+//! \brief Append value of type to vector.
+//! \param type Element type.
+//! \param p_vector Pointer to vector.
+//! \param value Value to append.
+#define cat_vector_push_of(type, p_vector, value)                 ((type*)cat_vector_append(cat_vector_check(p_vector, sizeof(type)), &(type){ value }, 1))
+
+
+//! \fn cat_vector_init
+//! \brief Initialize vector.
+//! \param p_vector Pointer to vector.
+//! \param p_allocator Pointer to allocator, copied into vector; null for system heap.
+//! \param element_size Size of element in bytes.
+//! \param capacity Number of elements to reserve; may be zero.
+//! \return True if successful.
+cat_decl bool cat_vector_init(cat_vector_t* const p_vector, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity);
+
+//! \fn cat_vector_term
+//! \brief Release vector storage.
+//! \param p_vector Pointer to vector.
+//! \return True if successful.
+cat_decl bool cat_vector_term(cat_vector_t* const p_vector);
+
+//! \fn cat_vector_check
+//! \brief Check element size of vector, e.g. for typed macros.
+//! \param p_vector Pointer to vector.
+//! \param element_size Expected size of element in bytes.
+//! \return Pointer to vector if element size matches; null otherwise.
+cat_decl cat_vector_t* cat_vector_check(cat_vector_t* const p_vector, size_t const element_size);
+
+//! \fn cat_vector_data
+//! \brief Get elements; pointer is invalidated by any operation that may grow or shrink storage.
+//! \param p_vector Pointer to vector.
+//! \return Pointer to first element; null if no storage reserved.
+cat_decl void* cat_vector_data(cat_vector_t const* const p_vector);
+
+//! \fn cat_vector_at
+//! \brief Get element.
+//! \param p_vector Pointer to vector.
+//! \param index Index of element.
+//! \return Pointer to element; null if index is out of range.
+cat_decl void* cat_vector_at(cat_vector_t const* const p_vector, size_t const index);
+
+//! \fn cat_vector_reserve
+//! \brief Grow storage to hold at least given number of elements.
+//! \param p_vector Pointer to vector.
+//! \param capacity Number of elements.
+//! \return True if successful; vector is unchanged if failed.
+cat_decl bool cat_vector_reserve(cat_vector_t* const p_vector, size_t const capacity);
+
+//! \fn cat_vector_shrink
+//! \brief Shrink storage to element count; storage is released if vector is empty.
+//! \param p_vector Pointer to vector.
+//! \return True if successful.
+cat_decl bool cat_vector_shrink(cat_vector_t* const p_vector);
+
+//! \fn cat_vector_resize
+//! \brief Set element count; new elements are zeroed.
+//! \param p_vector Pointer to vector.
+//! \param count Number of elements.
+//! \return True if successful.
+cat_decl bool cat_vector_resize(cat_vector_t* const p_vector, size_t const count);
+
+//! \fn cat_vector_clear
+//! \brief Remove all elements; storage is kept.
+//! \param p_vector Pointer to vector.
+//! \return True if successful.
+cat_decl bool cat_vector_clear(cat_vector_t* const p_vector);
+
+//! \fn cat_vector_append
+//! \brief Append elements to end of vector.
+//! \param p_vector Pointer to vector.
+//! \param p_elements Pointer to elements to copy; null to zero them; must not point into vector.
+//! \param count Number of elements; zero leaves vector unchanged.
+//! \return Pointer to first appended element, or end of vector if count is zero; null if failed or no storage is reserved.
+cat_decl void* cat_vector_append(cat_vector_t* const p_vector, void const* const p_elements, size_t const count);
+
+//! \fn cat_vector_insert
+//! \brief Insert elements before index, moving later elements up.
+//! \param p_vector Pointer to vector.
+//! \param index Index to insert at; up to element count.
+//! \param p_elements Pointer to elements to copy; null to zero them; must not point into vector.
+//! \param count Number of elements; zero leaves vector unchanged.
+//! \return Pointer to first inserted element, or element at index if count is zero; null if failed or no storage is reserved.
+cat_decl void* cat_vector_insert(cat_vector_t* const p_vector, size_t const index, void const* const p_elements, size_t const count);
+
+//! \fn cat_vector_erase
+//! \brief Remove elements at index, moving later elements down.
+//! \param p_vector Pointer to vector.
+//! \param index Index of first element to remove.
+//! \param count Number of elements; range must be in vector.
+//! \return True if successful.
+cat_decl bool cat_vector_erase(cat_vector_t* const p_vector, size_t const index, size_t const count);
+
+//! \fn cat_vector_pop
+//! \brief Remove last element.
+//! \param p_vector Pointer to vector.
+//! \param p_element_out Optional pointer to store copy of element.
+//! \return True if successful; false if empty.
+cat_decl bool cat_vector_pop(cat_vector_t* const p_vector, void* const p_element_out);
+
+
+cat_interface_end;
+
+
+#endif // #ifndef _CAT_VECTOR_H_
\ No newline at end of file
@@ -21,19 +21,58 @@
 
 #include "cat/cat.h"
 
+#include <string.h>
+
 
 extern void cat_time_test(void);
 extern void cat_console_test(void);
 extern void cat_memory_test(void);
+extern void cat_object_pool_test(void);
+extern void cat_vector_test(void);
+extern void cat_hash_map_test(void);
 extern void cat_thread_test(void);
+extern void cat_memory_bench(void);
+extern void cat_hash_map_bench(void);
+
+
+#define CAT_TEST_SCRATCH_SIZE (64 * 1024 * 1024)
 
 
 cat_noinl int cat_test_all(int const argc, char const* const argv[])
 {
-    unused2(argc, argv);
-    cat_time_test();
-    cat_console_test();
-    cat_memory_test();
-    cat_thread_test();
+    void(* const tests[])(void) = {
+        cat_time_test,
+        cat_console_test,
+        cat_memory_test,
+        cat_object_pool_test,
+        cat_vector_test,
+        cat_hash_map_test,
+        cat_thread_test,
+    };
+    size_t i = 0;
+    bool bench = false;
+
+    // benchmarks take long so only run when asked: cat bench
+    for (i = 1; i < (size_t)argc; ++i)
+        bench = bench || !strcmp(argv[i], "bench");
+
+    // every test may take temporaries from scratch arena; all released at once after test
+    cat_memory_scratch_create(CAT_TEST_SCRATCH_SIZE);
+    for (i = 0; i < array_count(tests); ++i)
+    {
+        tests[i]();
+        if (cat_memory_scratch())
+            cat_memory_arena_reset(cat_memory_scratch());
+    }
+    if (bench)
+    {
+        cat_memory_bench();
+        cat_hash_map_bench();
+    }
+    if (cat_memory_scratch())
+        cat_memory_scratch_destroy();
+
+    // blocks from cat_malloc still live at shutdown are leaks
+    cat_malloc_report(true);
     return 0;
 }
@@ -0,0 +1,542 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+* cat_hash_map.c
+* Open-addressing hash map implementation.
+*/
+
+#include "cat/utility/cat_hash_map.h"
+#include "cat/cat_platform.inl"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif // #ifdef _WIN32
+
+#if (defined _M_X64 || defined __x86_64__ || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define CAT_HASH_MAP_SSE2 1
+#include <emmintrin.h>
+#endif // #if (defined _M_X64 || defined __x86_64__ || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+
+
+cat_implementation_begin;
+
+
+#define CAT_HASH_MAP_EMPTY      ((uint8_t)0x80)
+#define CAT_HASH_MAP_TAG_BITS   7
+#define CAT_HASH_MAP_SLOT_ALIGN ((size_t)8)
+#define CAT_HASH_MAP_SEED       ((uint64_t)0x9E3779B97F4A7C15)
+
+
+static uint64_t cat_hash_map_internal_hash(void const* const p_key, size_t const key_size, uint64_t const seed)
+{
+    // keys up to one word are mixed inline, longer keys go through block hash
+    uint64_t word = 0;
+    if (key_size > sizeof(word))
+        return cat_memory_hash(p_key, key_size, seed);
+    memcpy(&word, p_key, key_size);
+    word ^= seed + key_size;
+    word = (word ^ (word >> 33)) * 0xFF51AFD7ED558CCDull;
+    word = (word ^ (word >> 33)) * 0xC4CEB9FE1A85EC53ull;
+    return (word ^ (word >> 33));
+}
+
+static bool cat_hash_map_internal_equal(void const* const p_key_lh, void const* const p_key_rh, size_t const key_size)
+{
+    return !memcmp(p_key_lh, p_key_rh, key_size);
+}
+
+static uint64_t cat_hash_map_internal_hash_key(cat_hash_map_t const* const p_map, void const* const p_key)
+{
+    // default hash called directly so it inlines into probe and erase loops
+    if (p_map->hash == &cat_hash_map_internal_hash)
+        return cat_hash_map_internal_hash(p_key, p_map->key_size, p_map->seed);
+    return p_map->hash(p_key, p_map->key_size, p_map->seed);
+}
+
+static bool cat_hash_map_internal_equal_key(cat_hash_map_t const* const p_map, void const* const p_key_lh, void const* const p_key_rh)
+{
+    // word-sized keys compared in one load each with default equality
+    uint64_t lh = 0, rh = 0;
+    if (p_map->equal != &cat_hash_map_internal_equal)
+        return p_map->equal(p_key_lh, p_key_rh, p_map->key_size);
+    if (p_map->key_size != sizeof(lh))
+        return !memcmp(p_key_lh, p_key_rh, p_map->key_size);
+    memcpy(&lh, p_key_lh, sizeof(lh));
+    memcpy(&rh, p_key_rh, sizeof(rh));
+    return (lh == rh);
+}
+
+static size_t cat_hash_map_internal_ctrl_size(size_t const capacity)
+{
+    // slots start aligned after control bytes and mirrored group
+    return ((capacity + CAT_HASH_MAP_GROUP + CAT_HASH_MAP_GROUP - 1) & ~(size_t)(CAT_HASH_MAP_GROUP - 1));
+}
+
+static uint8_t* cat_hash_map_internal_slot(cat_hash_map_t const* const p_map, size_t const index)
+{
+    return (p_map->p_slot + index * p_map->slot_size);
+}
+
+static void cat_hash_map_internal_set_ctrl(cat_hash_map_t* const p_map, size_t const index, uint8_t const ctrl)
+{
+    // first group is mirrored after last slot
+    p_map->p_ctrl[index] = ctrl;
+    if (index < CAT_HASH_MAP_GROUP)
+        p_map->p_ctrl[p_map->capacity + index] = ctrl;
+}
+
+static uint32_t cat_hash_map_internal_match(uint8_t const* const p_group, uint8_t const ctrl)
+{
+    // bit per control byte in group equal to value
+#ifdef CAT_HASH_MAP_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p_group), _mm_set1_epi8((char)ctrl)));
+#else // #ifdef CAT_HASH_MAP_SSE2
+    uint32_t mask = 0, i = 0;
+    for (i = 0; i < CAT_HASH_MAP_GROUP; ++i)
+        mask |= (uint32_t)(p_group[i] == ctrl) << i;
+    return mask;
+#endif // #else // #ifdef CAT_HASH_MAP_SSE2
+}
+
+static uint32_t cat_hash_map_internal_ctz(uint32_t const mask)
+{
+#ifdef _WIN32
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return (uint32_t)index;
+#else // #ifdef _WIN32
+    return (uint32_t)__builtin_ctz(mask);
+#endif // #else // #ifdef _WIN32
+}
+
+static size_t cat_hash_map_internal_probe(cat_hash_map_t const* const p_map, void const* const p_key, uint64_t const hash, bool* const p_found_out)
+{
+    // linear probe from home slot a group at a time; entries never lie past first empty slot of their probe
+    size_t const mask = p_map->capacity - 1;
+    uint8_t const tag = (uint8_t)(hash & ~(uint64_t)CAT_HASH_MAP_EMPTY);
+    size_t position = (size_t)(hash >> CAT_HASH_MAP_TAG_BITS) & mask, index = 0;
+    uint32_t match = 0, empty = 0;
+    for (;;)
+    {
+        match = cat_hash_map_internal_match(p_map->p_ctrl + position, tag);
+        empty = cat_hash_map_internal_match(p_map->p_ctrl + position, CAT_HASH_MAP_EMPTY);
+        if (empty)
+            match &= (empty & (0 - empty)) - 1;
+        while (match)
+        {
+            index = (position + cat_hash_map_internal_ctz(match)) & mask;
+            if (cat_hash_map_internal_equal_key(p_map, cat_hash_map_internal_slot(p_map, index), p_key))
+            {
+                *p_found_out = true;
+                return index;
+            }
+            match &= match - 1;
+        }
+        if (empty)
+        {
+            *p_found_out = false;
+            return (position + cat_hash_map_internal_ctz(empty)) & mask;
+        }
+        position = (position + CAT_HASH_MAP_GROUP) & mask;
+    }
+}
+
+static bool cat_hash_map_internal_rehash(cat_hash_map_t* const p_map, size_t const capacity)
+{
+    // move every entry into new storage; control bytes and slots share one block
+    cat_hash_map_t map_old = *p_map;
+    size_t const ctrl_size = cat_hash_map_internal_ctrl_size(capacity);
+    uint8_t* const p_block = (uint8_t*)cat_memory_allocator_alloc(&p_map->allocator, ctrl_size + capacity * p_map->slot_size);
+    size_t i = 0, index = 0;
+    bool found = false;
+    if (!p_block)
+        return false;
+    p_map->p_ctrl = p_block;
+    p_map->p_slot = p_block + ctrl_size;
+    p_map->capacity = capacity;
+    memset(p_map->p_ctrl, CAT_HASH_MAP_EMPTY, capacity + CAT_HASH_MAP_GROUP);
+    for (i = 0; i < map_old.capacity; ++i)
+    {
+        if (map_old.p_ctrl[i] == CAT_HASH_MAP_EMPTY)
+            continue;
+        index = cat_hash_map_internal_probe(p_map, cat_hash_map_internal_slot(&map_old, i), cat_hash_map_internal_hash_key(p_map, cat_hash_map_internal_slot(&map_old, i)), &found);
+        cat_hash_map_internal_set_ctrl(p_map, index, map_old.p_ctrl[i]);
+        memcpy(cat_hash_map_internal_slot(p_map, index), cat_hash_map_internal_slot(&map_old, i), p_map->slot_size);
+    }
+    if (map_old.p_ctrl)
+        cat_memory_allocator_dealloc(&p_map->allocator, map_old.p_ctrl, cat_hash_map_internal_ctrl_size(map_old.capacity) + map_old.capacity * p_map->slot_size);
+    return true;
+}
+
+
+cat_impl bool cat_hash_map_init(cat_hash_map_t* const p_map, cat_memory_allocator_t const* const p_allocator, size_t const key_size, size_t const value_size,
+    cat_hash_map_hash_t const hash, cat_hash_map_equal_t const equal, size_t const count)
+{
+    assert_or_bail(p_map) false;
+    assert_or_bail(key_size) false;
+    memset(p_map, 0, sizeof(*p_map));
+    p_map->allocator = (p_allocator ? *p_allocator : cat_memory_allocator_heap());
+    p_map->hash = (hash ? hash : &cat_hash_map_internal_hash);
+    p_map->equal = (equal ? equal : &cat_hash_map_internal_equal);
+    p_map->key_size = key_size;
+    p_map->value_size = value_size;
+    p_map->slot_size = (key_size + value_size + CAT_HASH_MAP_SLOT_ALIGN - 1) & ~(CAT_HASH_MAP_SLOT_ALIGN - 1);
+    p_map->seed = CAT_HASH_MAP_SEED ^ (uint64_t)(size_t)p_map;
+    return cat_hash_map_reserve(p_map, count);
+}
+
+cat_impl bool cat_hash_map_term(cat_hash_map_t* const p_map)
+{
+    assert_or_bail(p_map) false;
+    if (p_map->p_ctrl)
+        cat_memory_allocator_dealloc(&p_map->allocator, p_map->p_ctrl, cat_hash_map_internal_ctrl_size(p_map->capacity) + p_map->capacity * p_map->slot_size);
+    memset(p_map, 0, sizeof(*p_map));
+    return true;
+}
+
+cat_impl bool cat_hash_map_reserve(cat_hash_map_t* const p_map, size_t const count)
+{
+    // smallest power of two holding count at 7/8 load, at least one group
+    size_t capacity = CAT_HASH_MAP_GROUP;
+    assert_or_bail(p_map) false;
+    assert_or_bail(count <= SIZE_MAX / 8) false;
+    if (!count)
+        return true;
+    while (capacity - capacity / 8 < count)
+        capacity *= 2;
+    return (capacity <= p_map->capacity || cat_hash_map_internal_rehash(p_map, capacity));
+}
+
+cat_impl bool cat_hash_map_clear(cat_hash_map_t* const p_map)
+{
+    assert_or_bail(p_map) false;
+    if (p_map->p_ctrl)
+        memset(p_map->p_ctrl, CAT_HASH_MAP_EMPTY, p_map->capacity + CAT_HASH_MAP_GROUP);
+    p_map->count = 0;
+    return true;
+}
+
+cat_impl void* cat_hash_map_find(cat_hash_map_t const* const p_map, void const* const p_key)
+{
+    size_t index = 0;
+    bool found = false;
+    assert_or_bail(p_map) NULL;
+    assert_or_bail(p_key) NULL;
+    if (!p_map->count)
+        return NULL;
+    index = cat_hash_map_internal_probe(p_map, p_key, cat_hash_map_internal_hash_key(p_map, p_key), &found);
+    return (found ? cat_hash_map_internal_slot(p_map, index) + p_map->key_size : NULL);
+}
+
+cat_impl void* cat_hash_map_insert(cat_hash_map_t* const p_map, void const* const p_key, void const* const p_value, bool* const p_inserted_out)
+{
+    uint64_t hash = 0;
+    uint8_t* p_slot = NULL;
+    size_t index = 0;
+    bool found = false;
+    assert_or_bail(p_map) NULL;
+    assert_or_bail(p_key) NULL;
+    if (p_inserted_out)
+        *p_inserted_out = false;
+    if (p_map->count >= p_map->capacity - p_map->capacity / 8 && !cat_hash_map_reserve(p_map, p_map->count + 1))
+        return NULL;
+    hash = cat_hash_map_internal_hash_key(p_map, p_key);
+    index = cat_hash_map_internal_probe(p_map, p_key, hash, &found);
+    p_slot = cat_hash_map_internal_slot(p_map, index);
+    if (!found)
+    {
+        cat_hash_map_internal_set_ctrl(p_map, index, (uint8_t)(hash & ~(uint64_t)CAT_HASH_MAP_EMPTY));
+        memcpy(p_slot, p_key, p_map->key_size);
+        if (p_value)
+            memcpy(p_slot + p_map->key_size, p_value, p_map->value_size);
+        else
+            memset(p_slot + p_map->key_size, 0, p_map->value_size);
+        ++p_map->count;
+    }
+    if (p_inserted_out)
+        *p_inserted_out = !found;
+    return (p_slot + p_map->key_size);
+}
+
+cat_impl bool cat_hash_map_erase(cat_hash_map_t* const p_map, void const* const p_key)
+{
+    size_t mask = 0, hole = 0, index = 0, home = 0;
+    bool found = false;
+    assert_or_bail(p_map) false;
+    assert_or_bail(p_key) false;
+    if (!p_map->count)
+        return false;
+    mask = p_map->capacity - 1;
+    hole = cat_hash_map_internal_probe(p_map, p_key, cat_hash_map_internal_hash_key(p_map, p_key), &found);
+    if (!found)
+        return false;
+
+    // backward shift: each later entry of cluster whose home is not between hole and itself moves into hole
+    for (index = (hole + 1) & mask; p_map->p_ctrl[index] != CAT_HASH_MAP_EMPTY; index = (index + 1) & mask)
+    {
+        home = (size_t)(cat_hash_map_internal_hash_key(p_map, cat_hash_map_internal_slot(p_map, index)) >> CAT_HASH_MAP_TAG_BITS) & mask;
+        if (((hole - home) & mask) < ((index - home) & mask))
+        {
+            cat_hash_map_internal_set_ctrl(p_map, hole, p_map->p_ctrl[index]);
+            memcpy(cat_hash_map_internal_slot(p_map, hole), cat_hash_map_internal_slot(p_map, index), p_map->slot_size);
+            hole = index;
+        }
+    }
+    cat_hash_map_internal_set_ctrl(p_map, hole, CAT_HASH_MAP_EMPTY);
+    --p_map->count;
+    return true;
+}
+
+cat_impl void* cat_hash_map_next(cat_hash_map_t const* const p_map, size_t* const p_cursor, void const** const pp_key_out)
+{
+    size_t index = 0;
+    assert_or_bail(p_map) NULL;
+    assert_or_bail(p_cursor) NULL;
+    for (index = *p_cursor; index < p_map->capacity && p_map->p_ctrl[index] == CAT_HASH_MAP_EMPTY; ++index);
+    *p_cursor = index + 1;
+    if (index >= p_map->capacity)
+    {
+        *p_cursor = p_map->capacity;
+        return NULL;
+    }
+    if (pp_key_out)
+        *pp_key_out = cat_hash_map_internal_slot(p_map, index);
+    return (cat_hash_map_internal_slot(p_map, index) + p_map->key_size);
+}
+
+
+#include "cat/utility/cat_time.h"
+#include "cat/utility/cat_console.h"
+
+
+//! \struct cat_hash_map_test_node_s
+//! \brief Chained hash map node for comparison.
+typedef struct cat_hash_map_test_node_s
+{
+    uint64_t                          key;   //< Key.
+    uint64_t                          value; //< Value.
+    struct cat_hash_map_test_node_s*  p_next;//< Next node in bucket.
+} cat_hash_map_test_node_t;
+
+//! \struct cat_hash_map_test_chained_s
+//! \brief Chained hash map with bucket per slot and nodes from preallocated array, as reference for probing map.
+typedef struct cat_hash_map_test_chained_s
+{
+    cat_hash_map_test_node_t** p_bucket;//< Bucket heads.
+    cat_hash_map_test_node_t*  p_node;  //< Node storage.
+    cat_hash_map_test_node_t*  p_free;  //< Released nodes.
+    size_t                     mask;    //< Bucket count minus one.
+    size_t                     used;    //< Nodes handed out from storage.
+    uint64_t                   seed;    //< Hash seed.
+} cat_hash_map_test_chained_t;
+
+static cat_hash_map_test_node_t** cat_hash_map_test_chained_find(cat_hash_map_test_chained_t* const p_chained, uint64_t const key)
+{
+    cat_hash_map_test_node_t** pp_node = &p_chained->p_bucket[(cat_hash_map_internal_hash(&key, sizeof(key), p_chained->seed) >> CAT_HASH_MAP_TAG_BITS) & p_chained->mask];
+    while (*pp_node && (*pp_node)->key != key)
+        pp_node = &(*pp_node)->p_next;
+    return pp_node;
+}
+
+static bool cat_hash_map_test_chained_insert(cat_hash_map_test_chained_t* const p_chained, uint64_t const key, uint64_t const value)
+{
+    cat_hash_map_test_node_t** const pp_node = cat_hash_map_test_chained_find(p_chained, key);
+    cat_hash_map_test_node_t* p_node = p_chained->p_free;
+    if (*pp_node)
+        return false;
+    if (p_node)
+        p_chained->p_free = p_node->p_next;
+    else
+        p_node = &p_chained->p_node[p_chained->used++];
+    p_node->key = key;
+    p_node->value = value;
+    p_node->p_next = NULL;
+    *pp_node = p_node;
+    return true;
+}
+
+static bool cat_hash_map_test_chained_erase(cat_hash_map_test_chained_t* const p_chained, uint64_t const key)
+{
+    cat_hash_map_test_node_t** const pp_node = cat_hash_map_test_chained_find(p_chained, key);
+    cat_hash_map_test_node_t* const p_node = *pp_node;
+    if (!p_node)
+        return false;
+    *pp_node = p_node->p_next;
+    p_node->p_next = p_chained->p_free;
+    p_chained->p_free = p_node;
+    return true;
+}
+
+static uint64_t cat_hash_map_test_key(uint64_t const i)
+{
+    // distinct scattered keys; odd multiplier is a bijection
+    return (i + 1) * 0x9E3779B97F4A7C15ull;
+}
+
+static uint64_t cat_hash_map_test_key_shuffled(uint64_t const i, uint64_t const count)
+{
+    // same keys in another order so lookups do not follow insertion order through memory
+    return cat_hash_map_test_key(i / count * count + (i % count) * 2654435761ull % count);
+}
+
+
+cat_noinl void cat_hash_map_test(void)
+{
+    cat_memory_pool_t pool;
+    cat_memory_allocator_t allocator;
+    cat_hash_map_t map;
+    size_t const count = 100000;
+    size_t i = 0, cursor = 0, visited = 0, capacity = 0;
+    uint64_t key = 0, value = 0, sum = 0;
+    uint64_t* p_value = NULL;
+    void const* p_key = NULL;
+    bool inserted = false;
+    bool result = cat_memory_pool_init(&pool, 32 * 1024 * 1024);
+    allocator = cat_memory_allocator_pool(&pool);
+
+    // grow from empty, then every key found with its value and absent keys missed
+    result = result && cat_hash_map_init(&map, &allocator, sizeof(key), sizeof(value), NULL, NULL, 0);
+    for (i = 0; result && i < count; ++i)
+    {
+        key = cat_hash_map_test_key(i);
+        value = i;
+        result = cat_hash_map_insert(&map, &key, &value, &inserted) && inserted;
+    }
+    key = cat_hash_map_test_key(7);
+    result = result && (p_value = (uint64_t*)cat_hash_map_insert(&map, &key, NULL, &inserted)) && !inserted && (*p_value == 7) && (map.count == count);
+    for (i = 0; result && i < 2 * count; ++i)
+    {
+        key = cat_hash_map_test_key(i);
+        p_value = (uint64_t*)cat_hash_map_find(&map, &key);
+        result = (i < count ? p_value && *p_value == i : !p_value);
+    }
+
+    // erase every other key: survivors stay reachable after entries shift back, no tombstones are left
+    for (i = 0; result && i < count; i += 2)
+    {
+        key = cat_hash_map_test_key(i);
+        result = cat_hash_map_erase(&map, &key) && !cat_hash_map_erase(&map, &key);
+    }
+    for (i = 0; result && i < count; ++i)
+    {
+        key = cat_hash_map_test_key(i);
+        p_value = (uint64_t*)cat_hash_map_find(&map, &key);
+        result = (i % 2 ? p_value && *p_value == i : !p_value);
+    }
+    for (cursor = 0, sum = 0; result && (p_value = (uint64_t*)cat_hash_map_next(&map, &cursor, &p_key)) != NULL; ++visited)
+        sum += *p_value + (*(uint64_t const*)p_key != cat_hash_map_test_key(*p_value));
+    result = result && (visited == count / 2) && (sum == (uint64_t)(count / 2) * (count / 2));
+
+    // reserve up front means no rehash while filling
+    result = result && cat_hash_map_clear(&map) && cat_hash_map_reserve(&map, 3 * count);
+    capacity = map.capacity;
+    for (i = 0; result && i < 3 * count; ++i)
+    {
+        key = cat_hash_map_test_key(i);
+        result = (cat_hash_map_insert(&map, &key, NULL, NULL) != NULL);
+    }
+    result = result && (map.capacity == capacity) && (map.count == 3 * count);
+    printf("\nHash map: %s (%zu entries in %zu slots)", result ? "Success" : "Failed", map.count, map.capacity);
+    cat_hash_map_term(&map);
+    cat_memory_pool_term(&pool);
+}
+
+
+cat_noinl void cat_hash_map_bench(void)
+{
+    // operations per second at fixed slot count and rising load, probing map against chained map with same hash
+    static double const loads[] = { 0.5, 0.75, 0.875 };
+    size_t const capacity = (size_t)1 << 20;
+    double const rate = (double)cat_platform_time_rate();
+    cat_hash_map_t map;
+    cat_hash_map_test_chained_t chained;
+    cat_time_t t[2][4] = { { 0 } };
+    size_t i = 0, count = 0, found = 0, l = 0;
+    uint64_t key = 0;
+    bool result = true;
+    printf("\n\nHash map bench (M operations per second; insert, hit, miss, erase):");
+    for (l = 0; result && l < array_count(loads); ++l)
+    {
+        count = (size_t)(loads[l] * (double)capacity);
+        result = cat_hash_map_init(&map, NULL, sizeof(key), sizeof(key), NULL, NULL, count) && (map.capacity == capacity);
+        chained.p_bucket = (cat_hash_map_test_node_t**)cat_calloc(capacity, sizeof(*chained.p_bucket));
+        chained.p_node = (cat_hash_map_test_node_t*)cat_malloc(count * sizeof(*chained.p_node));
+        chained.p_free = NULL;
+        chained.mask = capacity - 1;
+        chained.used = 0;
+        chained.seed = map.seed;
+        result = result && chained.p_bucket && chained.p_node;
+
+        t[0][0] = cat_platform_time();
+        for (i = 0; result && i < count; ++i)
+        {
+            key = cat_hash_map_test_key(i);
+            result = (cat_hash_map_insert(&map, &key, &key, NULL) != NULL);
+        }
+        t[0][1] = cat_platform_time();
+        for (i = 0, found = 0; i < count; ++i)
+        {
+            key = cat_hash_map_test_key_shuffled(i, count);
+            found += (cat_hash_map_find(&map, &key) != NULL);
+        }
+        t[0][2] = cat_platform_time();
+        for (i = count; i < 2 * count; ++i)
+        {
+            key = cat_hash_map_test_key_shuffled(i, count);
+            found += (cat_hash_map_find(&map, &key) != NULL);
+        }
+        t[0][3] = cat_platform_time();
+        for (i = 0; i < count; ++i)
+        {
+            key = cat_hash_map_test_key_shuffled(i, count);
+            found -= cat_hash_map_erase(&map, &key);
+        }
+        result = result && !found && !map.count;
+        printf("\n    load %.3f: probing %.1f, %.1f, %.1f, %.1f", loads[l],
+            count * rate / (double)(t[0][1] - t[0][0]) * 1e-6, count * rate / (double)(t[0][2] - t[0][1]) * 1e-6,
+            count * rate / (double)(t[0][3] - t[0][2]) * 1e-6, count * rate / (double)(cat_platform_time() - t[0][3]) * 1e-6);
+
+        t[1][0] = cat_platform_time();
+        for (i = 0; result && i < count; ++i)
+            result = cat_hash_map_test_chained_insert(&chained, cat_hash_map_test_key(i), i);
+        t[1][1] = cat_platform_time();
+        for (i = 0, found = 0; i < count; ++i)
+            found += (*cat_hash_map_test_chained_find(&chained, cat_hash_map_test_key_shuffled(i, count)) != NULL);
+        t[1][2] = cat_platform_time();
+        for (i = count; i < 2 * count; ++i)
+            found += (*cat_hash_map_test_chained_find(&chained, cat_hash_map_test_key_shuffled(i, count)) != NULL);
+        t[1][3] = cat_platform_time();
+        for (i = 0; i < count; ++i)
+            found -= cat_hash_map_test_chained_erase(&chained, cat_hash_map_test_key_shuffled(i, count));
+        result = result && !found;
+        printf("; chained %.1f, %.1f, %.1f, %.1f",
+            count * rate / (double)(t[1][1] - t[1][0]) * 1e-6, count * rate / (double)(t[1][2] - t[1][1]) * 1e-6,
+            count * rate / (double)(t[1][3] - t[1][2]) * 1e-6, count * rate / (double)(cat_platform_time() - t[1][3]) * 1e-6);
+
+        if (chained.p_node)
+            cat_free(chained.p_node);
+        if (chained.p_bucket)
+            cat_free(chained.p_bucket);
+        cat_hash_map_term(&map);
+    }
+    printf("\nHash map bench: %s", result ? "Success" : "Failed");
+}
+
+
+cat_implementation_end;
\ No newline at end of file
@@ -19,225 +19,3177 @@
 * Memory management implementation.
 */
 
+#ifndef _WIN32
+#define _GNU_SOURCE // MAP_ANONYMOUS, MAP_HUGETLB, MAP_POPULATE, MADV_HUGEPAGE, SYS_mbind
+#endif // #ifndef _WIN32
+
 #include "cat/utility/cat_memory.h"
 #include "cat/cat_platform.inl"
 
 #include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
+#include <threads.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define cat_memory_caller() _ReturnAddress()
+#else // #ifdef _WIN32
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define cat_memory_caller() __builtin_return_address(0)
+#endif // #else // #ifdef _WIN32
+
+#if (defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__)
+#define CAT_MEMORY_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _WIN32
+#include <intrin.h>
+#endif // #ifdef _WIN32
+#endif // #if (defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__)
 
 
 cat_implementation_begin;
 
 
-#ifdef CAT_DEBUG
-typedef struct cat_malloc_metadata_s
+#ifdef CAT_DEBUG
+//! \enum cat_malloc_mode_e
+//! \brief Standard allocator that produced tracked block.
+typedef enum cat_malloc_mode_e
+{
+    cat_malloc_mode_malloc,
+    cat_malloc_mode_calloc,
+    cat_malloc_mode_realloc,
+} cat_malloc_mode_t;
+
+//! \struct cat_malloc_metadata_s
+//! \brief Tracked block record; slot in open-addressing table keyed by block address.
+typedef struct cat_malloc_metadata_s
+{
+    void const*       p_block; //< Tracked block; null if slot is empty.
+    char const*       file;    //< Source file of call site.
+    size_t            size;    //< Size of block in bytes.
+    uint32_t          line;    //< Source line of call site.
+    uint32_t          sequence;//< Allocation number, counted from start.
+    cat_malloc_mode_t mode;    //< Allocator that produced block.
+    uint32_t          reserved;//< Rounds size without implicit padding.
+} cat_malloc_metadata_t;
+
+//! \struct cat_malloc_tracker_s
+//! \brief Tracked block table.
+typedef struct cat_malloc_tracker_s
+{
+    cat_malloc_metadata_t* p_slot;   //< Table slots; capacity is power of two.
+    size_t                 capacity; //< Number of slots.
+    size_t                 count;    //< Number of tracked blocks.
+    uint32_t               sequence; //< Next allocation number.
+    bool                   overflow; //< Table could not grow so some blocks are untracked.
+    uint8_t                reserved[3];//< Keeps lock aligned without implicit padding.
+    mtx_t                  lock;     //< Table lock.
+} cat_malloc_tracker_t;
+
+#define CAT_MALLOC_TRACKER_MIN 256
+#endif // #ifdef CAT_DEBUG
+
+//! \struct cat_memory_block_s
+//! \brief Managed pool block header; precedes every block in the pool.
+typedef struct cat_memory_block_s
+{
+    size_t                     size;       //< Block size including header; lowest bit is the in-use flag.
+    struct cat_memory_block_s* p_prev_phys;//< Physically preceding block; null if first in pool.
+} cat_memory_block_t;
+
+//! \struct cat_memory_free_block_s
+//! \brief Free block; list links occupy the payload of unused blocks.
+typedef struct cat_memory_free_block_s
+{
+    cat_memory_block_t              block; //< Block header.
+    struct cat_memory_free_block_s* p_prev;//< Previous block in free list.
+    struct cat_memory_free_block_s* p_next;//< Next block in free list.
+} cat_memory_free_block_t;
+
+#define CAT_MEMORY_ALIGN        (sizeof(cat_memory_block_t))
+#define CAT_MEMORY_BLOCK_USED   ((size_t)1)
+#define CAT_MEMORY_BLOCK_MIN    (sizeof(cat_memory_free_block_t))
+_Static_assert((CAT_MEMORY_BLOCK_MIN % CAT_MEMORY_ALIGN) == 0, "Free block must be multiple of alignment.");
+
+//! \struct cat_memory_buddy_node_s
+//! \brief Free buddy block; list links occupy the block itself, allocated blocks have no header.
+typedef struct cat_memory_buddy_node_s
+{
+    struct cat_memory_buddy_node_s* p_prev;//< Previous block in free list of same order.
+    struct cat_memory_buddy_node_s* p_next;//< Next block in free list of same order.
+} cat_memory_buddy_node_t;
+
+#define CAT_MEMORY_BUDDY_SHIFT   5
+#define CAT_MEMORY_BUDDY_MIN     ((size_t)1 << CAT_MEMORY_BUDDY_SHIFT)
+#define CAT_MEMORY_BUDDY_ORDERS  48
+#define CAT_MEMORY_BUDDY_ALIGN   ((size_t)4096)
+_Static_assert(sizeof(cat_memory_buddy_node_t) <= CAT_MEMORY_BUDDY_MIN, "Buddy node must fit in smallest block.");
+
+//! \struct cat_memory_buddy_s
+//! \brief Buddy allocator state, stored at start of general region.
+//! Order k blocks are (CAT_MEMORY_BUDDY_MIN << k) bytes; a free bit is set for every block in a free list
+//! and a split bit for every block of order 1 or more that is divided into two buddies.
+typedef struct cat_memory_buddy_s
+{
+    cat_memory_buddy_node_t* p_free[CAT_MEMORY_BUDDY_ORDERS];    //< Free list per order.
+    size_t                   free_bit[CAT_MEMORY_BUDDY_ORDERS];  //< First bit of each order in free bitmap.
+    size_t                   split_bit[CAT_MEMORY_BUDDY_ORDERS]; //< First bit of each order in split bitmap.
+    uint64_t*                p_free_bits;                        //< Free bitmap.
+    uint64_t*                p_split_bits;                       //< Split bitmap.
+    uint8_t*                 p_base;                             //< First block.
+    size_t                   managed;                            //< Bytes covered by blocks.
+    size_t                   free;                               //< Bytes in free blocks.
+    uint32_t                 order_top;                          //< Order of span covering all blocks.
+    uint32_t                 reserved;                           //< Rounds size without implicit padding.
+} cat_memory_buddy_t;
+
+//! \struct cat_memory_slab_s
+//! \brief Slab descriptor; one per slab page, kept apart from pages so objects stay naturally aligned.
+typedef struct cat_memory_slab_s
+{
+    struct cat_memory_slab_s* p_prev;    //< Previous slab in partial list.
+    struct cat_memory_slab_s* p_next;    //< Next slab in partial list or free page list.
+    void*                     p_free;    //< Intrusive list of released objects in slab.
+    uint32_t                  live;      //< Number of objects in use.
+    uint32_t                  bump;      //< Number of objects ever handed out; rest are untouched.
+    uint32_t                  capacity;  //< Number of objects that fit in slab.
+    uint32_t                  size_class;//< Size class index.
+} cat_memory_slab_t;
+
+#define CAT_MEMORY_SLAB_SIZE     ((size_t)4096)
+#define CAT_MEMORY_SLAB_MIN      ((size_t)16)
+#define CAT_MEMORY_SLAB_MAX      ((size_t)2048)
+#define CAT_MEMORY_SLAB_FRACTION 4
+#define CAT_MEMORY_PAGE_SIZE      ((size_t)4096)
+#define CAT_MEMORY_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+#define CAT_MEMORY_POOL_FLAG_MAPPED (cat_memory_pool_flag_mapped | cat_memory_pool_flag_huge_pages | cat_memory_pool_flag_huge_tlb | cat_memory_pool_flag_prefault | cat_memory_pool_flag_node_local)
+_Static_assert((CAT_MEMORY_SLAB_MIN << (CAT_MEMORY_SLAB_CLASSES - 1)) == CAT_MEMORY_SLAB_MAX, "Slab classes must span min to max.");
+
+#define CAT_MEMORY_CACHE_SIZE    32
+#define CAT_MEMORY_CACHE_BATCH   (CAT_MEMORY_CACHE_SIZE / 2)
+
+//! \struct cat_memory_cache_s
+//! \brief Per-thread cache of slab objects for concurrent pool; exchanged with slabs in batches.
+typedef struct cat_memory_cache_s
+{
+    cat_memory_pool_t* p_pool;                                                  //< Owning pool.
+    uint32_t           count[CAT_MEMORY_SLAB_CLASSES];                          //< Number of cached objects per class.
+    void*              p_block[CAT_MEMORY_SLAB_CLASSES][CAT_MEMORY_CACHE_SIZE];//< Cached objects per class.
+} cat_memory_cache_t;
+
+#define CAT_MEMORY_GUARD_ALIGN ((size_t)16)
+
+//! \struct cat_memory_guard_slot_s
+//! \brief Guarded block record; slot page sits between two inaccessible guard pages.
+typedef struct cat_memory_guard_slot_s
+{
+    uint8_t*    p_block; //< Block placed against end of slot page; null if slot never used.
+    size_t      size;    //< Size of block in bytes.
+    void const* p_caller;//< Return address of allocating call.
+    char const* file;    //< Source file of call site if known.
+    uint32_t    line;    //< Source line of call site if known.
+    bool        live;    //< Block not yet released; page is inaccessible otherwise.
+    uint8_t     reserved[3];//< Rounds size without implicit padding.
+} cat_memory_guard_slot_t;
+
+//! \struct cat_memory_guard_s
+//! \brief Sampled guarded allocations; region alternates guard pages and slot pages, starting and ending with guard.
+typedef struct cat_memory_guard_s
+{
+    uint8_t*                 p_region;    //< Guard region; null if never enabled.
+    size_t                   region_size; //< Size of region in bytes.
+    cat_memory_guard_slot_t* p_slot;      //< Slot records.
+    uint32_t                 slot_count;  //< Number of slots.
+    uint32_t                 slot_next;   //< Next slot to try; round robin so released slots stay protected longest.
+    uint32_t                 live;        //< Number of live guarded blocks.
+    uint32_t                 sampled;     //< Number of blocks placed in slots since enabled.
+    uint32_t volatile        sample_rate; //< Mean allocations per sampled one; zero if disabled.
+    uint32_t                 reserved;    //< Keeps lock aligned without implicit padding.
+    mtx_t                    lock;        //< Lock for slots.
+#ifdef _WIN32
+    void*                    p_handler;   //< Vectored exception handler.
+#else // #ifdef _WIN32
+    struct sigaction         handler_prev;//< Fault handler replaced by guard handler.
+#endif // #else // #ifdef _WIN32
+} cat_memory_guard_t;
+
+static cat_memory_pool_t memoryDefault;
+static cat_memory_arena_t memoryScratch;
+
+
+static size_t cat_memory_internal_align(size_t const size, size_t const align)
+{
+    return ((size + align - 1) & ~(align - 1));
+}
+
+static size_t cat_memory_internal_block_size(cat_memory_block_t const* const p_block)
+{
+    return (p_block->size & ~CAT_MEMORY_BLOCK_USED);
+}
+
+static bool cat_memory_internal_block_used(cat_memory_block_t const* const p_block)
+{
+    return ((p_block->size & CAT_MEMORY_BLOCK_USED) != 0);
+}
+
+static cat_memory_block_t* cat_memory_internal_block_next(cat_memory_pool_t* const p_pool, cat_memory_block_t const* const p_block)
+{
+    cat_memory_block_t* const p_next = (cat_memory_block_t*)((uint8_t*)p_block + cat_memory_internal_block_size(p_block));
+    return (p_next < p_pool->p_end ? p_next : NULL);
+}
+
+static void cat_memory_internal_free_push(cat_memory_pool_t* const p_pool, cat_memory_free_block_t* const p_free)
+{
+    // insert at head of free list
+    p_free->p_prev = NULL;
+    p_free->p_next = p_pool->p_free_head;
+    if (p_pool->p_free_head)
+        p_pool->p_free_head->p_prev = p_free;
+    p_pool->p_free_head = p_free;
+}
+
+static void cat_memory_internal_free_pop(cat_memory_pool_t* const p_pool, cat_memory_free_block_t* const p_free)
+{
+    // unlink from anywhere in free list
+    if (p_free->p_prev)
+        p_free->p_prev->p_next = p_free->p_next;
+    else
+        p_pool->p_free_head = p_free->p_next;
+    if (p_free->p_next)
+        p_free->p_next->p_prev = p_free->p_prev;
+    p_free->p_prev = p_free->p_next = NULL;
+}
+
+static size_t cat_memory_internal_free_gap(cat_memory_free_block_t const* const p_free, size_t const align)
+{
+    // bytes to skip so payload is aligned; a gap too small to be a free block is given
+    // to the preceding block instead, so it only moves on if there is no predecessor
+    size_t const payload = (size_t)(&p_free->block + 1);
+    size_t gap = cat_memory_internal_align(payload, align) - payload;
+    if (gap && gap < CAT_MEMORY_BLOCK_MIN && !p_free->block.p_prev_phys)
+        gap = cat_memory_internal_align(payload + CAT_MEMORY_BLOCK_MIN, align) - payload;
+    return gap;
+}
+
+static cat_memory_free_block_t* cat_memory_internal_free_find(cat_memory_pool_t* const p_pool, size_t const size, size_t const align)
+{
+    cat_memory_free_block_t* p_free = p_pool->p_free_head, * p_best = NULL;
+    size_t free_size = 0, need = size, best_size = SIZE_MAX;
+    bool const aligned = (align > CAT_MEMORY_ALIGN);
+    if (p_pool->policy == cat_memory_policy_first_fit)
+    {
+        // first block that is large enough
+        for (; p_free; p_free = p_free->p_next)
+        {
+            if (aligned)
+                need = size + cat_memory_internal_free_gap(p_free, align);
+            if (cat_memory_internal_block_size(&p_free->block) >= need)
+                break;
+        }
+        return p_free;
+    }
+
+    // block with least space left over, exact fit ends search
+    for (; p_free; p_free = p_free->p_next)
+    {
+        free_size = cat_memory_internal_block_size(&p_free->block);
+        if (aligned)
+            need = size + cat_memory_internal_free_gap(p_free, align);
+        if (free_size >= need && free_size - need < best_size)
+        {
+            p_best = p_free;
+            best_size = free_size - need;
+            if (!best_size)
+                break;
+        }
+    }
+    return p_best;
+}
+
+static void cat_memory_internal_block_split(cat_memory_pool_t* const p_pool, cat_memory_block_t* const p_block, size_t const size)
+{
+    // carve remainder into new free block if large enough to hold one
+    size_t const block_size = cat_memory_internal_block_size(p_block);
+    cat_memory_free_block_t* p_rest = NULL;
+    cat_memory_block_t* p_next = NULL;
+    if (block_size - size < CAT_MEMORY_BLOCK_MIN)
+        return;
+    p_rest = (cat_memory_free_block_t*)((uint8_t*)p_block + size);
+    p_rest->block.size = block_size - size;
+    p_rest->block.p_prev_phys = p_block;
+    p_block->size = size | (p_block->size & CAT_MEMORY_BLOCK_USED);
+    p_next = cat_memory_internal_block_next(p_pool, &p_rest->block);
+    if (p_next)
+        p_next->p_prev_phys = &p_rest->block;
+    cat_memory_internal_free_push(p_pool, p_rest);
+}
+
+static cat_memory_block_t* cat_memory_internal_block_merge(cat_memory_pool_t* const p_pool, cat_memory_block_t* const p_block)
+{
+    // absorb free neighbors on both sides; result is not in free list
+    cat_memory_block_t* p_result = p_block, * p_next = cat_memory_internal_block_next(p_pool, p_block);
+    cat_memory_block_t* const p_prev = p_block->p_prev_phys;
+    if (p_next && !cat_memory_internal_block_used(p_next))
+    {
+        cat_memory_internal_free_pop(p_pool, (cat_memory_free_block_t*)p_next);
+        p_result->size += cat_memory_internal_block_size(p_next);
+    }
+    if (p_prev && !cat_memory_internal_block_used(p_prev))
+    {
+        cat_memory_internal_free_pop(p_pool, (cat_memory_free_block_t*)p_prev);
+        p_prev->size += cat_memory_internal_block_size(p_result);
+        p_result = p_prev;
+    }
+    p_next = cat_memory_internal_block_next(p_pool, p_result);
+    if (p_next)
+        p_next->p_prev_phys = p_result;
+    return p_result;
+}
+
+static uint32_t cat_memory_internal_histogram_bin(size_t const block_size)
+{
+    // floor of log2, last bin holds everything larger
+    uint32_t bin = 0;
+    while (bin + 1 < CAT_MEMORY_HISTOGRAM_BINS && (block_size >> (bin + 1)))
+        ++bin;
+    return bin;
+}
+
+static void* cat_memory_internal_block_alloc(cat_memory_pool_t* const p_pool, size_t const block_size, size_t const align)
+{
+    cat_memory_free_block_t* p_free = NULL;
+    cat_memory_block_t* p_block = NULL, * p_prev = NULL, * p_next = NULL;
+    size_t size = 0, gap = 0;
+
+    // total size with header, never smaller than a free block
+    if (block_size > p_pool->size)
+        return NULL;
+    size = cat_memory_internal_align(block_size + sizeof(cat_memory_block_t), CAT_MEMORY_ALIGN);
+    if (size < CAT_MEMORY_BLOCK_MIN)
+        size = CAT_MEMORY_BLOCK_MIN;
+
+    // take free block
+    p_free = cat_memory_internal_free_find(p_pool, size, align);
+    if (!p_free)
+        return NULL;
+    cat_memory_internal_free_pop(p_pool, p_free);
+    p_block = &p_free->block;
+
+    // move block forward to aligned position: large gap stays free, small gap extends predecessor
+    if (align > CAT_MEMORY_ALIGN && (gap = cat_memory_internal_free_gap(p_free, align)) != 0)
+    {
+        p_block = (cat_memory_block_t*)((uint8_t*)p_free + gap);
+        p_block->size = cat_memory_internal_block_size(&p_free->block) - gap;
+        if (gap >= CAT_MEMORY_BLOCK_MIN)
+        {
+            p_free->block.size = gap;
+            p_block->p_prev_phys = &p_free->block;
+            cat_memory_internal_free_push(p_pool, p_free);
+        }
+        else
+        {
+            p_prev = p_free->block.p_prev_phys;
+            --p_pool->histogram[cat_memory_internal_histogram_bin(cat_memory_internal_block_size(p_prev))];
+            p_prev->size += gap;
+            ++p_pool->histogram[cat_memory_internal_histogram_bin(cat_memory_internal_block_size(p_prev))];
+            p_pool->used += gap;
+            p_block->p_prev_phys = p_prev;
+        }
+        p_next = cat_memory_internal_block_next(p_pool, p_block);
+        if (p_next)
+            p_next->p_prev_phys = p_block;
+    }
+
+    // return remainder to list
+    p_block->size |= CAT_MEMORY_BLOCK_USED;
+    cat_memory_internal_block_split(p_pool, p_block, size);
+
+    p_pool->used += cat_memory_internal_block_size(p_block);
+    ++p_pool->block_count;
+    return (void*)(p_block + 1);
+}
+
+static bool cat_memory_internal_block_dealloc(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    // validate block belongs to pool and is live
+    cat_memory_block_t* p_header = (cat_memory_block_t*)p_block - 1;
+    assert_or_bail(p_header >= p_pool->p_begin && p_header < p_pool->p_end) false;
+    assert_or_bail(cat_memory_internal_block_used(p_header)) false;
+
+    // release and coalesce with neighbors
+    p_header->size &= ~CAT_MEMORY_BLOCK_USED;
+    p_pool->used -= cat_memory_internal_block_size(p_header);
+    --p_pool->block_count;
+    p_header = cat_memory_internal_block_merge(p_pool, p_header);
+    cat_memory_internal_free_push(p_pool, (cat_memory_free_block_t*)p_header);
+    return true;
+}
+
+static bool cat_memory_internal_block_realloc(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size)
+{
+    // resize in place: shrink splits off tail, grow absorbs free successor; false if block has to move
+    cat_memory_block_t* const p_header = (cat_memory_block_t*)p_block - 1;
+    cat_memory_block_t* p_next = NULL, * p_rest = NULL;
+    size_t const current = cat_memory_internal_block_size(p_header);
+    size_t size = 0;
+    assert_or_bail(p_header >= p_pool->p_begin && p_header < p_pool->p_end) false;
+    assert_or_bail(cat_memory_internal_block_used(p_header)) false;
+    if (block_size > p_pool->size)
+        return false;
+    size = cat_memory_internal_align(block_size + sizeof(cat_memory_block_t), CAT_MEMORY_ALIGN);
+    if (size < CAT_MEMORY_BLOCK_MIN)
+        size = CAT_MEMORY_BLOCK_MIN;
+    if (size > current)
+    {
+        p_next = cat_memory_internal_block_next(p_pool, p_header);
+        if (!p_next || cat_memory_internal_block_used(p_next) || current + cat_memory_internal_block_size(p_next) < size)
+            return false;
+        cat_memory_internal_free_pop(p_pool, (cat_memory_free_block_t*)p_next);
+        p_header->size += cat_memory_internal_block_size(p_next);
+        p_next = cat_memory_internal_block_next(p_pool, p_header);
+        if (p_next)
+            p_next->p_prev_phys = p_header;
+    }
+
+    // split tail and coalesce it with free successor
+    cat_memory_internal_block_split(p_pool, p_header, size);
+    p_rest = cat_memory_internal_block_next(p_pool, p_header);
+    if (p_rest && !cat_memory_internal_block_used(p_rest))
+    {
+        cat_memory_internal_free_pop(p_pool, (cat_memory_free_block_t*)p_rest);
+        p_rest = cat_memory_internal_block_merge(p_pool, p_rest);
+        cat_memory_internal_free_push(p_pool, (cat_memory_free_block_t*)p_rest);
+    }
+    p_pool->used = p_pool->used - current + cat_memory_internal_block_size(p_header);
+    return true;
+}
+
+static bool cat_memory_internal_bit_get(uint64_t const* const p_bits, size_t const bit)
+{
+    return ((p_bits[bit >> 6] >> (bit & 63)) & 1);
+}
+
+static void cat_memory_internal_bit_set(uint64_t* const p_bits, size_t const bit, bool const value)
+{
+    if (value)
+        p_bits[bit >> 6] |= ((uint64_t)1 << (bit & 63));
+    else
+        p_bits[bit >> 6] &= ~((uint64_t)1 << (bit & 63));
+}
+
+static uint32_t cat_memory_internal_buddy_order(size_t const size)
+{
+    // smallest order whose block fits
+    uint32_t order = 0;
+    while ((CAT_MEMORY_BUDDY_MIN << order) < size)
+        ++order;
+    return order;
+}
+
+static void cat_memory_internal_buddy_push(cat_memory_buddy_t* const p_buddy, uint32_t const order, size_t const index)
+{
+    cat_memory_buddy_node_t* const p_node = (cat_memory_buddy_node_t*)(p_buddy->p_base + (index << (order + CAT_MEMORY_BUDDY_SHIFT)));
+    p_node->p_prev = NULL;
+    p_node->p_next = p_buddy->p_free[order];
+    if (p_node->p_next)
+        p_node->p_next->p_prev = p_node;
+    p_buddy->p_free[order] = p_node;
+    cat_memory_internal_bit_set(p_buddy->p_free_bits, p_buddy->free_bit[order] + index, true);
+    p_buddy->free += (CAT_MEMORY_BUDDY_MIN << order);
+}
+
+static void cat_memory_internal_buddy_pop(cat_memory_buddy_t* const p_buddy, uint32_t const order, cat_memory_buddy_node_t* const p_node)
+{
+    size_t const index = (size_t)((uint8_t*)p_node - p_buddy->p_base) >> (order + CAT_MEMORY_BUDDY_SHIFT);
+    if (p_node->p_prev)
+        p_node->p_prev->p_next = p_node->p_next;
+    else
+        p_buddy->p_free[order] = p_node->p_next;
+    if (p_node->p_next)
+        p_node->p_next->p_prev = p_node->p_prev;
+    cat_memory_internal_bit_set(p_buddy->p_free_bits, p_buddy->free_bit[order] + index, false);
+    p_buddy->free -= (CAT_MEMORY_BUDDY_MIN << order);
+}
+
+static bool cat_memory_internal_buddy_init(cat_memory_pool_t* const p_pool)
+{
+    // metadata at start of general region, blocks after it; span is power-of-two blocks covering region
+    uint8_t* const p_region = (uint8_t*)p_pool->p_begin, * const p_end = (uint8_t*)p_pool->p_end;
+    cat_memory_buddy_t* const p_buddy = (cat_memory_buddy_t*)p_region;
+    size_t const region = (size_t)(p_end - p_region);
+    size_t span = 0, free_bits = 0, split_bits = 0, offset = 0, managed = 0;
+    uint32_t order = 0, top = 0, k = 0;
+    if (region <= sizeof(cat_memory_buddy_t) + CAT_MEMORY_BUDDY_ALIGN)
+        return false;
+    while ((CAT_MEMORY_BUDDY_MIN << top) < region && top + 1 < CAT_MEMORY_BUDDY_ORDERS)
+        ++top;
+    span = (size_t)1 << top;
+    memset(p_buddy, 0, sizeof(*p_buddy));
+    for (order = 0; order <= top; ++order)
+    {
+        p_buddy->free_bit[order] = free_bits;
+        p_buddy->split_bit[order] = split_bits;
+        free_bits += (span >> order);
+        split_bits += (order ? (span >> order) : 0);
+    }
+    p_buddy->order_top = top;
+    p_buddy->p_free_bits = (uint64_t*)(p_buddy + 1);
+    p_buddy->p_split_bits = p_buddy->p_free_bits + (free_bits + 63) / 64;
+    p_buddy->p_base = (uint8_t*)cat_memory_internal_align((size_t)(p_buddy->p_split_bits + (split_bits + 63) / 64), CAT_MEMORY_BUDDY_ALIGN);
+    if (p_buddy->p_base + CAT_MEMORY_BUDDY_MIN > p_end)
+        return false;
+    memset(p_buddy->p_free_bits, 0, (size_t)((uint8_t*)(p_buddy->p_split_bits + (split_bits + 63) / 64) - (uint8_t*)p_buddy->p_free_bits));
+    managed = (size_t)(p_end - p_buddy->p_base) & ~(CAT_MEMORY_BUDDY_MIN - 1);
+
+    // cover region with largest aligned blocks; their ancestors count as split so they never merge past the end
+    while (offset < managed)
+    {
+        order = 0;
+        while (order < top && !(offset & ((CAT_MEMORY_BUDDY_MIN << (order + 1)) - 1)) && offset + (CAT_MEMORY_BUDDY_MIN << (order + 1)) <= managed)
+            ++order;
+        cat_memory_internal_buddy_push(p_buddy, order, offset >> (order + CAT_MEMORY_BUDDY_SHIFT));
+        for (k = order + 1; k <= top; ++k)
+            cat_memory_internal_bit_set(p_buddy->p_split_bits, p_buddy->split_bit[k] + (offset >> (k + CAT_MEMORY_BUDDY_SHIFT)), true);
+        offset += (CAT_MEMORY_BUDDY_MIN << order);
+    }
+    p_buddy->managed = managed;
+    p_pool->p_buddy = p_buddy;
+    return true;
+}
+
+static void* cat_memory_internal_buddy_alloc(cat_memory_pool_t* const p_pool, size_t const block_size, size_t const align)
+{
+    // block of at least alignment is aligned to its size since base is page-aligned
+    cat_memory_buddy_t* const p_buddy = p_pool->p_buddy;
+    cat_memory_buddy_node_t* p_node = NULL;
+    size_t index = 0;
+    uint32_t const order = cat_memory_internal_buddy_order(block_size > align ? block_size : align);
+    uint32_t k = order;
+    if (order > p_buddy->order_top || align > CAT_MEMORY_BUDDY_ALIGN)
+        return NULL;
+    while (k <= p_buddy->order_top && !p_buddy->p_free[k])
+        ++k;
+    if (k > p_buddy->order_top)
+        return NULL;
+
+    // split down to requested order, upper halves become free buddies
+    p_node = p_buddy->p_free[k];
+    cat_memory_internal_buddy_pop(p_buddy, k, p_node);
+    index = (size_t)((uint8_t*)p_node - p_buddy->p_base) >> (k + CAT_MEMORY_BUDDY_SHIFT);
+    while (k > order)
+    {
+        cat_memory_internal_bit_set(p_buddy->p_split_bits, p_buddy->split_bit[k] + index, true);
+        --k;
+        index <<= 1;
+        cat_memory_internal_buddy_push(p_buddy, k, index + 1);
+    }
+
+    p_pool->used += (CAT_MEMORY_BUDDY_MIN << order);
+    ++p_pool->block_count;
+    return p_node;
+}
+
+static uint32_t cat_memory_internal_buddy_order_of(cat_memory_buddy_t const* const p_buddy, size_t const offset)
+{
+    // live block order: climb while parent is not split
+    uint32_t order = 0;
+    while (order < p_buddy->order_top && !cat_memory_internal_bit_get(p_buddy->p_split_bits, p_buddy->split_bit[order + 1] + (offset >> (order + 1 + CAT_MEMORY_BUDDY_SHIFT))))
+        ++order;
+    return order;
+}
+
+static bool cat_memory_internal_buddy_dealloc(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    cat_memory_buddy_t* const p_buddy = p_pool->p_buddy;
+    size_t const offset = (size_t)((uint8_t*)p_block - p_buddy->p_base);
+    size_t index = 0;
+    uint32_t order = 0;
+    assert_or_bail((uint8_t*)p_block >= p_buddy->p_base && offset < p_buddy->managed) false;
+    assert_or_bail(!(offset & (CAT_MEMORY_BUDDY_MIN - 1))) false;
+
+    order = cat_memory_internal_buddy_order_of(p_buddy, offset);
+    index = offset >> (order + CAT_MEMORY_BUDDY_SHIFT);
+    assert_or_bail(!(offset & ((CAT_MEMORY_BUDDY_MIN << order) - 1))) false;
+    assert_or_bail(!cat_memory_internal_bit_get(p_buddy->p_free_bits, p_buddy->free_bit[order] + index)) false;
+    p_pool->used -= (CAT_MEMORY_BUDDY_MIN << order);
+    --p_pool->block_count;
+
+    // merge with free buddy while possible
+    while (order < p_buddy->order_top && cat_memory_internal_bit_get(p_buddy->p_free_bits, p_buddy->free_bit[order] + (index ^ 1)))
+    {
+        cat_memory_internal_buddy_pop(p_buddy, order, (cat_memory_buddy_node_t*)(p_buddy->p_base + ((index ^ 1) << (order + CAT_MEMORY_BUDDY_SHIFT))));
+        ++order;
+        index >>= 1;
+        cat_memory_internal_bit_set(p_buddy->p_split_bits, p_buddy->split_bit[order] + index, false);
+    }
+    cat_memory_internal_buddy_push(p_buddy, order, index);
+    return true;
+}
+
+static bool cat_memory_internal_buddy_realloc(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size)
+{
+    // shrink frees upper halves; grow needs block to be left half at each level with whole buddy free
+    cat_memory_buddy_t* const p_buddy = p_pool->p_buddy;
+    size_t const offset = (size_t)((uint8_t*)p_block - p_buddy->p_base);
+    size_t index = 0;
+    uint32_t const need = cat_memory_internal_buddy_order(block_size);
+    uint32_t order = 0, k = 0;
+    assert_or_bail((uint8_t*)p_block >= p_buddy->p_base && offset < p_buddy->managed) false;
+    order = cat_memory_internal_buddy_order_of(p_buddy, offset);
+    if (need > p_buddy->order_top)
+        return false;
+    for (k = order, index = offset >> (order + CAT_MEMORY_BUDDY_SHIFT); k < need; ++k, index >>= 1)
+        if ((index & 1) || !cat_memory_internal_bit_get(p_buddy->p_free_bits, p_buddy->free_bit[k] + (index ^ 1)))
+            return false;
+    for (k = order, index = offset >> (order + CAT_MEMORY_BUDDY_SHIFT); k < need; ++k, index >>= 1)
+    {
+        cat_memory_internal_buddy_pop(p_buddy, k, (cat_memory_buddy_node_t*)(p_buddy->p_base + ((index ^ 1) << (k + CAT_MEMORY_BUDDY_SHIFT))));
+        cat_memory_internal_bit_set(p_buddy->p_split_bits, p_buddy->split_bit[k + 1] + (index >> 1), false);
+    }
+    for (k = order; k > need; --k)
+    {
+        index = offset >> (k + CAT_MEMORY_BUDDY_SHIFT);
+        cat_memory_internal_bit_set(p_buddy->p_split_bits, p_buddy->split_bit[k] + index, true);
+        cat_memory_internal_buddy_push(p_buddy, k - 1, 2 * index + 1);
+    }
+    p_pool->used = p_pool->used - (CAT_MEMORY_BUDDY_MIN << order) + (CAT_MEMORY_BUDDY_MIN << need);
+    return true;
+}
+
+static bool cat_memory_internal_buddy_validate(cat_memory_pool_t* const p_pool)
+{
+    // every listed block has its free bit and no free block has a free buddy
+    cat_memory_buddy_t const* const p_buddy = p_pool->p_buddy;
+    cat_memory_buddy_node_t const* p_node = NULL;
+    size_t index = 0, free = 0;
+    uint32_t order = 0;
+    for (order = 0; order <= p_buddy->order_top; ++order)
+    {
+        for (p_node = p_buddy->p_free[order]; p_node; p_node = p_node->p_next)
+        {
+            index = (size_t)((uint8_t const*)p_node - p_buddy->p_base) >> (order + CAT_MEMORY_BUDDY_SHIFT);
+            if (!cat_memory_internal_bit_get(p_buddy->p_free_bits, p_buddy->free_bit[order] + index))
+                return false;
+            if (order < p_buddy->order_top && cat_memory_internal_bit_get(p_buddy->p_free_bits, p_buddy->free_bit[order] + (index ^ 1)))
+                return false;
+            free += (CAT_MEMORY_BUDDY_MIN << order);
+        }
+    }
+    return (free == p_buddy->free && free + p_pool->used == p_buddy->managed);
+}
+
+static size_t cat_memory_internal_in_use(cat_memory_pool_t const* const p_pool)
+{
+    // caller holds pool lock if concurrent; slab pages count whole
+    return p_pool->used + (size_t)p_pool->slab_pages * CAT_MEMORY_SLAB_SIZE;
+}
+
+static void cat_memory_internal_peak(cat_memory_pool_t* const p_pool)
+{
+    // caller holds pool lock if concurrent
+    size_t const in_use = cat_memory_internal_in_use(p_pool);
+    if (in_use > p_pool->peak)
+        p_pool->peak = in_use;
+}
+
+static void cat_memory_internal_free_extent(cat_memory_pool_t const* const p_pool, size_t* const p_free_out, size_t* const p_largest_out)
+{
+    // caller holds pool lock if concurrent
+    cat_memory_free_block_t const* p_free = NULL;
+    size_t free = 0, largest = 0, size = 0;
+    uint32_t order = 0;
+    if (p_pool->backend == cat_memory_backend_buddy)
+    {
+        free = p_pool->p_buddy->free;
+        for (order = 0; order <= p_pool->p_buddy->order_top; ++order)
+            if (p_pool->p_buddy->p_free[order])
+                largest = (CAT_MEMORY_BUDDY_MIN << order);
+    }
+    else
+    {
+        for (p_free = p_pool->p_free_head; p_free; p_free = p_free->p_next)
+        {
+            size = cat_memory_internal_block_size(&p_free->block);
+            free += size;
+            largest = (size > largest ? size : largest);
+        }
+    }
+    *p_free_out = free;
+    *p_largest_out = largest;
+}
+
+static bool cat_memory_internal_general_owns(cat_memory_pool_t const* const p_pool, void const* const p_block)
+{
+    if (p_pool->backend == cat_memory_backend_buddy)
+        return ((uint8_t const*)p_block >= p_pool->p_buddy->p_base && (uint8_t const*)p_block < p_pool->p_buddy->p_base + p_pool->p_buddy->managed);
+    return ((cat_memory_block_t const*)p_block - 1 >= p_pool->p_begin && (cat_memory_block_t const*)p_block - 1 < p_pool->p_end);
+}
+
+static size_t cat_memory_internal_general_size(cat_memory_pool_t const* const p_pool, void const* const p_block)
+{
+    // reserved size of live general block, including header
+    if (p_pool->backend == cat_memory_backend_buddy)
+        return (CAT_MEMORY_BUDDY_MIN << cat_memory_internal_buddy_order_of(p_pool->p_buddy, (size_t)((uint8_t const*)p_block - p_pool->p_buddy->p_base)));
+    return cat_memory_internal_block_size((cat_memory_block_t const*)p_block - 1);
+}
+
+static void* cat_memory_internal_general_alloc(cat_memory_pool_t* const p_pool, size_t const block_size, size_t const align)
+{
+    // caller holds pool lock if concurrent; reserved bytes per request feed internal fragmentation
+    size_t const used = p_pool->used;
+    void* const p_block = (p_pool->backend == cat_memory_backend_buddy ?
+        cat_memory_internal_buddy_alloc(p_pool, block_size, align) :
+        cat_memory_internal_block_alloc(p_pool, block_size, align));
+    if (p_block)
+    {
+        p_pool->requested_total += block_size;
+        p_pool->reserved_total += (p_pool->used - used);
+        ++p_pool->histogram[cat_memory_internal_histogram_bin(cat_memory_internal_general_size(p_pool, p_block))];
+        cat_memory_internal_peak(p_pool);
+    }
+    return p_block;
+}
+
+static bool cat_memory_internal_general_dealloc(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    // caller holds pool lock if concurrent; block must be in range before its size is read
+    bool result = false;
+    uint32_t bin = 0;
+    assert_or_bail(cat_memory_internal_general_owns(p_pool, p_block)) false;
+    bin = cat_memory_internal_histogram_bin(cat_memory_internal_general_size(p_pool, p_block));
+    result = (p_pool->backend == cat_memory_backend_buddy ?
+        cat_memory_internal_buddy_dealloc(p_pool, p_block) :
+        cat_memory_internal_block_dealloc(p_pool, p_block));
+    if (result)
+        --p_pool->histogram[bin];
+    return result;
+}
+
+static bool cat_memory_internal_general_realloc(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size)
+{
+    // caller holds pool lock if concurrent; counts as new request for internal fragmentation
+    uint32_t bin = 0;
+    size_t size = 0;
+    bool result = false;
+    assert_or_bail(cat_memory_internal_general_owns(p_pool, p_block)) false;
+    bin = cat_memory_internal_histogram_bin(cat_memory_internal_general_size(p_pool, p_block));
+    result = (p_pool->backend == cat_memory_backend_buddy ?
+        cat_memory_internal_buddy_realloc(p_pool, p_block, block_size) :
+        cat_memory_internal_block_realloc(p_pool, p_block, block_size));
+    if (result)
+    {
+        size = cat_memory_internal_general_size(p_pool, p_block);
+        --p_pool->histogram[bin];
+        ++p_pool->histogram[cat_memory_internal_histogram_bin(size)];
+        p_pool->requested_total += block_size;
+        p_pool->reserved_total += size;
+        cat_memory_internal_peak(p_pool);
+    }
+    return result;
+}
+
+static bool cat_memory_internal_concurrent(cat_memory_pool_t const* const p_pool)
+{
+    return ((p_pool->flags & cat_memory_pool_flag_concurrent) != 0);
+}
+
+static void cat_memory_internal_lock(cat_memory_pool_t const* const p_pool, mtx_t* const p_lock)
+{
+    if (cat_memory_internal_concurrent(p_pool))
+        mtx_lock(p_lock);
+}
+
+static void cat_memory_internal_unlock(cat_memory_pool_t const* const p_pool, mtx_t* const p_lock)
+{
+    if (cat_memory_internal_concurrent(p_pool))
+        mtx_unlock(p_lock);
+}
+
+static uint32_t cat_memory_internal_slab_class(size_t const block_size)
+{
+    // smallest power-of-two class that fits
+    uint32_t size_class = 0;
+    while ((CAT_MEMORY_SLAB_MIN << size_class) < block_size)
+        ++size_class;
+    return size_class;
+}
+
+static uint8_t* cat_memory_internal_slab_page(cat_memory_pool_t* const p_pool, cat_memory_slab_t const* const p_slab)
+{
+    return (p_pool->p_slab_begin + (size_t)(p_slab - p_pool->p_slab_table) * CAT_MEMORY_SLAB_SIZE);
+}
+
+static cat_memory_slab_t* cat_memory_internal_slab_owner(cat_memory_pool_t* const p_pool, void const* const p_block)
+{
+    return (p_pool->p_slab_table + (size_t)((uint8_t const*)p_block - p_pool->p_slab_begin) / CAT_MEMORY_SLAB_SIZE);
+}
+
+static size_t cat_memory_internal_slab_used(cat_memory_pool_t const* const p_pool)
+{
+    size_t used = 0;
+    uint32_t i = 0;
+    for (i = 0; i < CAT_MEMORY_SLAB_CLASSES; ++i)
+        used += (size_t)p_pool->slab_class[i].live * (CAT_MEMORY_SLAB_MIN << i);
+    return used;
+}
+
+static void cat_memory_internal_slab_link(cat_memory_pool_t* const p_pool, cat_memory_slab_t* const p_slab)
+{
+    // insert at head of partial list for class
+    cat_memory_slab_t** const pp_head = &p_pool->slab_class[p_slab->size_class].p_partial;
+    p_slab->p_prev = NULL;
+    p_slab->p_next = *pp_head;
+    if (*pp_head)
+        (*pp_head)->p_prev = p_slab;
+    *pp_head = p_slab;
+}
+
+static void cat_memory_internal_slab_unlink(cat_memory_pool_t* const p_pool, cat_memory_slab_t* const p_slab)
+{
+    // remove from partial list for class
+    if (p_slab->p_prev)
+        p_slab->p_prev->p_next = p_slab->p_next;
+    else
+        p_pool->slab_class[p_slab->size_class].p_partial = p_slab->p_next;
+    if (p_slab->p_next)
+        p_slab->p_next->p_prev = p_slab->p_prev;
+    p_slab->p_prev = p_slab->p_next = NULL;
+}
+
+static cat_memory_slab_t* cat_memory_internal_slab_acquire(cat_memory_pool_t* const p_pool, uint32_t const size_class)
+{
+    // reuse released page, otherwise take next untouched page; pages are shared by all classes
+    cat_memory_slab_t* p_slab = NULL;
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    p_slab = p_pool->p_slab_free;
+    if (p_slab)
+        p_pool->p_slab_free = p_slab->p_next;
+    else if (p_pool->slab_bump < p_pool->slab_count)
+        p_slab = p_pool->p_slab_table + p_pool->slab_bump++;
+    if (p_slab)
+    {
+        ++p_pool->slab_pages;
+        cat_memory_internal_peak(p_pool);
+    }
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    if (!p_slab)
+        return NULL;
+    p_slab->p_free = NULL;
+    p_slab->live = p_slab->bump = 0;
+    p_slab->capacity = (uint32_t)(CAT_MEMORY_SLAB_SIZE / (CAT_MEMORY_SLAB_MIN << size_class));
+    p_slab->size_class = size_class;
+    cat_memory_internal_slab_link(p_pool, p_slab);
+    return p_slab;
+}
+
+static void* cat_memory_internal_slab_alloc(cat_memory_pool_t* const p_pool, uint32_t const size_class)
+{
+    // caller holds class lock if concurrent
+    cat_memory_slab_t* p_slab = p_pool->slab_class[size_class].p_partial;
+    void* p_block = NULL;
+    if (!p_slab)
+    {
+        p_slab = cat_memory_internal_slab_acquire(p_pool, size_class);
+        if (!p_slab)
+            return NULL;
+    }
+
+    // pop released object or bump into untouched part of slab
+    if (p_slab->p_free)
+    {
+        p_block = p_slab->p_free;
+        p_slab->p_free = *(void**)p_block;
+    }
+    else
+        p_block = cat_memory_internal_slab_page(p_pool, p_slab) + (size_t)p_slab->bump++ * (CAT_MEMORY_SLAB_MIN << size_class);
+    if (++p_slab->live == p_slab->capacity)
+        cat_memory_internal_slab_unlink(p_pool, p_slab);
+
+    ++p_pool->slab_class[size_class].live;
+    return p_block;
+}
+
+static bool cat_memory_internal_slab_dealloc(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    // caller holds class lock if concurrent; owning slab follows from page index
+    cat_memory_slab_t* const p_slab = cat_memory_internal_slab_owner(p_pool, p_block);
+    assert_or_bail(p_slab < p_pool->p_slab_table + p_pool->slab_bump && p_slab->live) false;
+    assert_or_bail(((size_t)((uint8_t*)p_block - p_pool->p_slab_begin) % (CAT_MEMORY_SLAB_MIN << p_slab->size_class)) == 0) false;
+
+    // push object and relink slab if it was full
+    *(void**)p_block = p_slab->p_free;
+    p_slab->p_free = p_block;
+    if (p_slab->live-- == p_slab->capacity)
+        cat_memory_internal_slab_link(p_pool, p_slab);
+    --p_pool->slab_class[p_slab->size_class].live;
+
+    // return empty page unless it is the only one left for class
+    if (!p_slab->live && (p_slab->p_prev || p_slab->p_next))
+    {
+        cat_memory_internal_slab_unlink(p_pool, p_slab);
+        cat_memory_internal_lock(p_pool, &p_pool->lock);
+        p_slab->p_next = p_pool->p_slab_free;
+        p_pool->p_slab_free = p_slab;
+        --p_pool->slab_pages;
+        cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    }
+    return true;
+}
+
+static void cat_memory_internal_cache_flush(cat_memory_cache_t* const p_cache, uint32_t const size_class, uint32_t const count)
+{
+    // return oldest cached objects to slabs under one class lock
+    cat_memory_pool_t* const p_pool = p_cache->p_pool;
+    uint32_t* const p_count = &p_cache->count[size_class];
+    void** const p_block = p_cache->p_block[size_class];
+    uint32_t i = 0;
+    if (!count)
+        return;
+    cat_memory_internal_lock(p_pool, &p_pool->slab_class[size_class].lock);
+    for (i = 0; i < count; ++i)
+        cat_memory_internal_slab_dealloc(p_pool, p_block[i]);
+    cat_memory_internal_unlock(p_pool, &p_pool->slab_class[size_class].lock);
+    *p_count -= count;
+    if (*p_count)
+        memmove(p_block, p_block + count, *p_count * sizeof(*p_block));
+}
+
+static void cat_memory_internal_cache_release(void* const p_data)
+{
+    // thread exit or pool termination: return everything to pool
+    cat_memory_cache_t* const p_cache = (cat_memory_cache_t*)p_data;
+    cat_memory_pool_t* const p_pool = p_cache->p_pool;
+    uint32_t i = 0;
+    for (i = 0; i < CAT_MEMORY_SLAB_CLASSES; ++i)
+        cat_memory_internal_cache_flush(p_cache, i, p_cache->count[i]);
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    cat_memory_internal_general_dealloc(p_pool, p_cache);
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+}
+
+static cat_memory_cache_t* cat_memory_internal_cache_get(cat_memory_pool_t* const p_pool)
+{
+    // cache for calling thread, created from general blocks on first use
+    cat_memory_cache_t* p_cache = (cat_memory_cache_t*)tss_get(p_pool->cache_key);
+    if (p_cache)
+        return p_cache;
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    p_cache = (cat_memory_cache_t*)cat_memory_internal_general_alloc(p_pool, sizeof(cat_memory_cache_t), CAT_MEMORY_ALIGN);
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    if (!p_cache)
+        return NULL;
+    memset(p_cache, 0, sizeof(*p_cache));
+    p_cache->p_pool = p_pool;
+    if (tss_set(p_pool->cache_key, p_cache) != thrd_success)
+    {
+        cat_memory_internal_cache_release(p_cache);
+        return NULL;
+    }
+    return p_cache;
+}
+
+static void* cat_memory_internal_cache_alloc(cat_memory_pool_t* const p_pool, uint32_t const size_class)
+{
+    cat_memory_cache_t* const p_cache = cat_memory_internal_cache_get(p_pool);
+    mtx_t* const p_lock = &p_pool->slab_class[size_class].lock;
+    uint32_t* p_count = NULL;
+    void* p_block = NULL;
+    if (!p_cache)
+    {
+        // no cache for thread, go straight to slabs
+        mtx_lock(p_lock);
+        p_block = cat_memory_internal_slab_alloc(p_pool, size_class);
+        mtx_unlock(p_lock);
+        return p_block;
+    }
+
+    // refill half of cache under one class lock when empty
+    p_count = &p_cache->count[size_class];
+    if (!*p_count)
+    {
+        mtx_lock(p_lock);
+        while (*p_count < CAT_MEMORY_CACHE_BATCH && (p_block = cat_memory_internal_slab_alloc(p_pool, size_class)) != NULL)
+            p_cache->p_block[size_class][(*p_count)++] = p_block;
+        mtx_unlock(p_lock);
+        if (!*p_count)
+            return NULL;
+    }
+    return p_cache->p_block[size_class][--(*p_count)];
+}
+
+static bool cat_memory_internal_cache_dealloc(cat_memory_pool_t* const p_pool, void* const p_block, uint32_t const size_class)
+{
+    cat_memory_cache_t* const p_cache = cat_memory_internal_cache_get(p_pool);
+    mtx_t* const p_lock = &p_pool->slab_class[size_class].lock;
+    bool result = false;
+    if (!p_cache)
+    {
+        mtx_lock(p_lock);
+        result = cat_memory_internal_slab_dealloc(p_pool, p_block);
+        mtx_unlock(p_lock);
+        return result;
+    }
+
+    // flush half of cache under one class lock when full
+    if (p_cache->count[size_class] == CAT_MEMORY_CACHE_SIZE)
+        cat_memory_internal_cache_flush(p_cache, size_class, CAT_MEMORY_CACHE_BATCH);
+    p_cache->p_block[size_class][p_cache->count[size_class]++] = p_block;
+    return true;
+}
+
+static bool cat_memory_internal_pool_validate(cat_memory_pool_t* const p_pool)
+{
+    // walk physical blocks: links consistent, sizes cover pool, no adjacent free blocks
+    cat_memory_block_t const* p_block = p_pool->p_begin, * p_prev = NULL;
+    cat_memory_free_block_t const* p_free = p_pool->p_free_head;
+    size_t used = 0, free_count = 0, list_count = 0;
+    if (p_pool->backend == cat_memory_backend_buddy)
+        return cat_memory_internal_buddy_validate(p_pool);
+    while (p_block)
+    {
+        if (p_block->p_prev_phys != p_prev)
+            return false;
+        if (cat_memory_internal_block_used(p_block))
+            used += cat_memory_internal_block_size(p_block);
+        else if (p_prev && !cat_memory_internal_block_used(p_prev))
+            return false;
+        else
+            ++free_count;
+        p_prev = p_block;
+        p_block = cat_memory_internal_block_next(p_pool, p_block);
+    }
+    if ((uint8_t*)p_prev + cat_memory_internal_block_size(p_prev) != (uint8_t*)p_pool->p_end)
+        return false;
+    for (; p_free; p_free = p_free->p_next, ++list_count)
+        if (cat_memory_internal_block_used(&p_free->block))
+            return false;
+    return (used == p_pool->used && free_count == list_count);
+}
+
+//! \struct cat_memory_kernels_s
+//! \brief Block kernels selected for instruction set.
+typedef struct cat_memory_kernels_s
+{
+    void(*memset)(void* const, uint8_t const, size_t const);            //< Set kernel.
+    void(*memcpy)(void* const, void const* const, size_t const);        //< Copy kernel.
+    bool(*memcmp)(void const* const, void const* const, size_t const);  //< Equality kernel.
+    size_t(*mismatch)(void const* const, void const* const, size_t const);//< First mismatch kernel; returns size if equal.
+    void(*hash)(uint64_t* const, uint8_t const* const, size_t const, uint64_t const* const);//< Hash stripe kernel.
+    cat_memory_simd_t simd;                                             //< Active instruction set.
+    cat_memory_simd_t supported;                                        //< Widest supported instruction set.
+} cat_memory_kernels_t;
+
+// blocks at least this large are written with non-temporal stores so they do not evict the working set from cache
+#define CAT_MEMORY_STREAM_SIZE ((size_t)4 * 1024 * 1024)
+
+// hash consumes 64-byte stripes into eight 64-bit lanes and scrambles lanes every 16 stripes; all kernels give same result
+#define CAT_MEMORY_HASH_LANES    8
+#define CAT_MEMORY_HASH_STRIPE   64
+#define CAT_MEMORY_HASH_SCRAMBLE 16
+#define CAT_MEMORY_PRIME32_1     0x9E3779B1u
+#define CAT_MEMORY_PRIME64_1     0x9E3779B185EBCA87ull
+#define CAT_MEMORY_PRIME64_2     0xC2B2AE3D27D4EB4Full
+
+static cat_memory_kernels_t memoryKernels;
+static once_flag memoryKernelsOnce = ONCE_FLAG_INIT;
+
+static void cat_memory_internal_memset_libc(void* const p_block, uint8_t const value, size_t const set_size)
+{
+    memset(p_block, value, set_size);
+}
+
+static void cat_memory_internal_memcpy_libc(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+{
+    memcpy(p_block_dst, p_block_src, cpy_size);
+}
+
+static bool cat_memory_internal_memcmp_libc(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    return (memcmp(p_block_lh, p_block_rh, cmp_size) == 0);
+}
+
+static uint32_t cat_memory_internal_ctz64(uint64_t const value)
+{
+    // value is non-zero
+#ifdef _WIN32
+    unsigned long index = 0;
+#ifdef CAT_64BIT
+    _BitScanForward64(&index, value);
+#else // #ifdef CAT_64BIT
+    if (!_BitScanForward(&index, (unsigned long)value))
+    {
+        _BitScanForward(&index, (unsigned long)(value >> 32));
+        index += 32;
+    }
+#endif // #else // #ifdef CAT_64BIT
+    return (uint32_t)index;
+#else // #ifdef _WIN32
+    return (uint32_t)__builtin_ctzll(value);
+#endif // #else // #ifdef _WIN32
+}
+
+static uint64_t cat_memory_internal_read64(uint8_t const* const p)
+{
+    // little-endian load without alignment requirement
+    uint64_t value = 0;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint64_t cat_memory_internal_rotl64(uint64_t const value, uint32_t const bits)
+{
+    return ((value << bits) | (value >> (64 - bits)));
+}
+
+static uint64_t cat_memory_internal_fmix64(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+static size_t cat_memory_internal_mismatch_scalar(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    uint64_t diff = 0;
+    size_t i = 0;
+    for (; i + 8 <= cmp_size; i += 8)
+    {
+        diff = cat_memory_internal_read64(lh + i) ^ cat_memory_internal_read64(rh + i);
+        if (diff)
+            return i + cat_memory_internal_ctz64(diff) / 8;
+    }
+    for (; i < cmp_size; ++i)
+        if (lh[i] != rh[i])
+            return i;
+    return cmp_size;
+}
+
+static void cat_memory_internal_hash_scalar(uint64_t* const acc, uint8_t const* const p_data, size_t const stripe_count, uint64_t const* const key)
+{
+    // per lane: acc += lo32(data ^ key) * hi32(data ^ key), and data goes to neighbour lane; scramble is acc = (acc ^ acc >> 47 ^ key) * prime
+    uint64_t data = 0, data_key = 0;
+    size_t s = 0;
+    uint32_t i = 0;
+    for (s = 0; s < stripe_count; ++s)
+    {
+        for (i = 0; i < CAT_MEMORY_HASH_LANES; ++i)
+        {
+            data = cat_memory_internal_read64(p_data + s * CAT_MEMORY_HASH_STRIPE + i * 8);
+            data_key = data ^ key[i];
+            acc[i ^ 1] += data;
+            acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+        }
+        if ((s + 1) % CAT_MEMORY_HASH_SCRAMBLE == 0)
+            for (i = 0; i < CAT_MEMORY_HASH_LANES; ++i)
+                acc[i] = (acc[i] ^ (acc[i] >> 47) ^ key[i]) * CAT_MEMORY_PRIME32_1;
+    }
+}
+
+#ifdef CAT_MEMORY_SIMD_X86
+// each kernel: unaligned head, aligned body to end of last full vector, overlapping unaligned tail; short blocks go to narrower kernel
+
+static cat_target("sse2") void cat_memory_internal_memset_sse2(void* const p_block, uint8_t const value, size_t const set_size)
+{
+    uint8_t* p = (uint8_t*)p_block, * const p_end = p + set_size;
+    __m128i const v = _mm_set1_epi8((char)value);
+    if (set_size < 16)
+    {
+        memset(p_block, value, set_size);
+        return;
+    }
+    _mm_storeu_si128((__m128i*)p, v);
+    p = (uint8_t*)(((size_t)p + 16) & ~(size_t)15);
+    if (set_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; p + 16 <= p_end; p += 16)
+            _mm_stream_si128((__m128i*)p, v);
+        _mm_sfence();
+    }
+    else
+    {
+        for (; p + 64 <= p_end; p += 64)
+        {
+            _mm_store_si128((__m128i*)p, v);
+            _mm_store_si128((__m128i*)(p + 16), v);
+            _mm_store_si128((__m128i*)(p + 32), v);
+            _mm_store_si128((__m128i*)(p + 48), v);
+        }
+        for (; p + 16 <= p_end; p += 16)
+            _mm_store_si128((__m128i*)p, v);
+    }
+    _mm_storeu_si128((__m128i*)(p_end - 16), v);
+}
+
+static cat_target("sse2") void cat_memory_internal_memcpy_sse2(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+{
+    uint8_t* d = (uint8_t*)p_block_dst, * const d_end = d + cpy_size;
+    uint8_t const* s = (uint8_t const*)p_block_src, * const s_end = s + cpy_size;
+    __m128i tail;
+    if (cpy_size < 16)
+    {
+        memcpy(p_block_dst, p_block_src, cpy_size);
+        return;
+    }
+    tail = _mm_loadu_si128((__m128i const*)(s_end - 16));
+    _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+    s += (((size_t)d + 16) & ~(size_t)15) - (size_t)d;
+    d = (uint8_t*)(((size_t)d + 16) & ~(size_t)15);
+    if (cpy_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; d + 16 <= d_end; d += 16, s += 16)
+            _mm_stream_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d + 64 <= d_end; d += 64, s += 64)
+        {
+            _mm_store_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+            _mm_store_si128((__m128i*)(d + 16), _mm_loadu_si128((__m128i const*)(s + 16)));
+            _mm_store_si128((__m128i*)(d + 32), _mm_loadu_si128((__m128i const*)(s + 32)));
+            _mm_store_si128((__m128i*)(d + 48), _mm_loadu_si128((__m128i const*)(s + 48)));
+        }
+        for (; d + 16 <= d_end; d += 16, s += 16)
+            _mm_store_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+    }
+    _mm_storeu_si128((__m128i*)(d_end - 16), tail);
+}
+
+static cat_target("sse2") bool cat_memory_internal_memcmp_sse2(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    size_t i = 0;
+    if (cmp_size < 16)
+        return (memcmp(p_block_lh, p_block_rh, cmp_size) == 0);
+    for (; i + 64 <= cmp_size; i += 64)
+    {
+        __m128i const e0 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i)), _mm_loadu_si128((__m128i const*)(rh + i)));
+        __m128i const e1 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i + 16)), _mm_loadu_si128((__m128i const*)(rh + i + 16)));
+        __m128i const e2 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i + 32)), _mm_loadu_si128((__m128i const*)(rh + i + 32)));
+        __m128i const e3 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i + 48)), _mm_loadu_si128((__m128i const*)(rh + i + 48)));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3))) != 0xFFFF)
+            return false;
+    }
+    for (; i + 16 <= cmp_size; i += 16)
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i)), _mm_loadu_si128((__m128i const*)(rh + i)))) != 0xFFFF)
+            return false;
+    return (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + cmp_size - 16)), _mm_loadu_si128((__m128i const*)(rh + cmp_size - 16)))) == 0xFFFF);
+}
+
+static cat_target("avx2") void cat_memory_internal_memset_avx2(void* const p_block, uint8_t const value, size_t const set_size)
+{
+    uint8_t* p = (uint8_t*)p_block, * const p_end = p + set_size;
+    __m256i const v = _mm256_set1_epi8((char)value);
+    if (set_size < 32)
+    {
+        cat_memory_internal_memset_sse2(p_block, value, set_size);
+        return;
+    }
+    _mm256_storeu_si256((__m256i*)p, v);
+    p = (uint8_t*)(((size_t)p + 32) & ~(size_t)31);
+    if (set_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; p + 32 <= p_end; p += 32)
+            _mm256_stream_si256((__m256i*)p, v);
+        _mm_sfence();
+    }
+    else
+    {
+        for (; p + 128 <= p_end; p += 128)
+        {
+            _mm256_store_si256((__m256i*)p, v);
+            _mm256_store_si256((__m256i*)(p + 32), v);
+            _mm256_store_si256((__m256i*)(p + 64), v);
+            _mm256_store_si256((__m256i*)(p + 96), v);
+        }
+        for (; p + 32 <= p_end; p += 32)
+            _mm256_store_si256((__m256i*)p, v);
+    }
+    _mm256_storeu_si256((__m256i*)(p_end - 32), v);
+}
+
+static cat_target("avx2") void cat_memory_internal_memcpy_avx2(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+{
+    uint8_t* d = (uint8_t*)p_block_dst, * const d_end = d + cpy_size;
+    uint8_t const* s = (uint8_t const*)p_block_src, * const s_end = s + cpy_size;
+    __m256i tail;
+    if (cpy_size < 32)
+    {
+        cat_memory_internal_memcpy_sse2(p_block_dst, p_block_src, cpy_size);
+        return;
+    }
+    tail = _mm256_loadu_si256((__m256i const*)(s_end - 32));
+    _mm256_storeu_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+    s += (((size_t)d + 32) & ~(size_t)31) - (size_t)d;
+    d = (uint8_t*)(((size_t)d + 32) & ~(size_t)31);
+    if (cpy_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; d + 32 <= d_end; d += 32, s += 32)
+            _mm256_stream_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d + 128 <= d_end; d += 128, s += 128)
+        {
+            _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+            _mm256_store_si256((__m256i*)(d + 32), _mm256_loadu_si256((__m256i const*)(s + 32)));
+            _mm256_store_si256((__m256i*)(d + 64), _mm256_loadu_si256((__m256i const*)(s + 64)));
+            _mm256_store_si256((__m256i*)(d + 96), _mm256_loadu_si256((__m256i const*)(s + 96)));
+        }
+        for (; d + 32 <= d_end; d += 32, s += 32)
+            _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+    }
+    _mm256_storeu_si256((__m256i*)(d_end - 32), tail);
+}
+
+static cat_target("avx2") bool cat_memory_internal_memcmp_avx2(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    size_t i = 0;
+    if (cmp_size < 32)
+        return cat_memory_internal_memcmp_sse2(p_block_lh, p_block_rh, cmp_size);
+    for (; i + 128 <= cmp_size; i += 128)
+    {
+        __m256i const e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i)), _mm256_loadu_si256((__m256i const*)(rh + i)));
+        __m256i const e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i + 32)), _mm256_loadu_si256((__m256i const*)(rh + i + 32)));
+        __m256i const e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i + 64)), _mm256_loadu_si256((__m256i const*)(rh + i + 64)));
+        __m256i const e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i + 96)), _mm256_loadu_si256((__m256i const*)(rh + i + 96)));
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(e0, e1), _mm256_and_si256(e2, e3))) != UINT32_MAX)
+            return false;
+    }
+    for (; i + 32 <= cmp_size; i += 32)
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i)), _mm256_loadu_si256((__m256i const*)(rh + i)))) != UINT32_MAX)
+            return false;
+    return ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + cmp_size - 32)), _mm256_loadu_si256((__m256i const*)(rh + cmp_size - 32)))) == UINT32_MAX);
+}
+
+static cat_target("avx512f,avx512bw") void cat_memory_internal_memset_avx512(void* const p_block, uint8_t const value, size_t const set_size)
+{
+    uint8_t* p = (uint8_t*)p_block, * const p_end = p + set_size;
+    __m512i const v = _mm512_set1_epi8((char)value);
+    if (set_size < 64)
+    {
+        cat_memory_internal_memset_avx2(p_block, value, set_size);
+        return;
+    }
+    _mm512_storeu_si512((void*)p, v);
+    p = (uint8_t*)(((size_t)p + 64) & ~(size_t)63);
+    if (set_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; p + 64 <= p_end; p += 64)
+            _mm512_stream_si512((void*)p, v);
+        _mm_sfence();
+    }
+    else
+    {
+        for (; p + 256 <= p_end; p += 256)
+        {
+            _mm512_store_si512((void*)p, v);
+            _mm512_store_si512((void*)(p + 64), v);
+            _mm512_store_si512((void*)(p + 128), v);
+            _mm512_store_si512((void*)(p + 192), v);
+        }
+        for (; p + 64 <= p_end; p += 64)
+            _mm512_store_si512((void*)p, v);
+    }
+    _mm512_storeu_si512((void*)(p_end - 64), v);
+}
+
+static cat_target("avx512f,avx512bw") void cat_memory_internal_memcpy_avx512(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+{
+    uint8_t* d = (uint8_t*)p_block_dst, * const d_end = d + cpy_size;
+    uint8_t const* s = (uint8_t const*)p_block_src, * const s_end = s + cpy_size;
+    __m512i tail;
+    if (cpy_size < 64)
+    {
+        cat_memory_internal_memcpy_avx2(p_block_dst, p_block_src, cpy_size);
+        return;
+    }
+    tail = _mm512_loadu_si512((void const*)(s_end - 64));
+    _mm512_storeu_si512((void*)d, _mm512_loadu_si512((void const*)s));
+    s += (((size_t)d + 64) & ~(size_t)63) - (size_t)d;
+    d = (uint8_t*)(((size_t)d + 64) & ~(size_t)63);
+    if (cpy_size >= CAT_MEMORY_STREAM_SIZE)
+    {
+        for (; d + 64 <= d_end; d += 64, s += 64)
+            _mm512_stream_si512((void*)d, _mm512_loadu_si512((void const*)s));
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d + 256 <= d_end; d += 256, s += 256)
+        {
+            _mm512_store_si512((void*)d, _mm512_loadu_si512((void const*)s));
+            _mm512_store_si512((void*)(d + 64), _mm512_loadu_si512((void const*)(s + 64)));
+            _mm512_store_si512((void*)(d + 128), _mm512_loadu_si512((void const*)(s + 128)));
+            _mm512_store_si512((void*)(d + 192), _mm512_loadu_si512((void const*)(s + 192)));
+        }
+        for (; d + 64 <= d_end; d += 64, s += 64)
+            _mm512_store_si512((void*)d, _mm512_loadu_si512((void const*)s));
+    }
+    _mm512_storeu_si512((void*)(d_end - 64), tail);
+}
+
+static cat_target("avx512f,avx512bw") bool cat_memory_internal_memcmp_avx512(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    size_t i = 0;
+    if (cmp_size < 64)
+        return cat_memory_internal_memcmp_avx2(p_block_lh, p_block_rh, cmp_size);
+    for (; i + 256 <= cmp_size; i += 256)
+    {
+        __mmask64 const n0 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i)), _mm512_loadu_si512((void const*)(rh + i)));
+        __mmask64 const n1 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i + 64)), _mm512_loadu_si512((void const*)(rh + i + 64)));
+        __mmask64 const n2 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i + 128)), _mm512_loadu_si512((void const*)(rh + i + 128)));
+        __mmask64 const n3 = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i + 192)), _mm512_loadu_si512((void const*)(rh + i + 192)));
+        if (n0 | n1 | n2 | n3)
+            return false;
+    }
+    for (; i + 64 <= cmp_size; i += 64)
+        if (_mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i)), _mm512_loadu_si512((void const*)(rh + i))))
+            return false;
+    return !_mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + cmp_size - 64)), _mm512_loadu_si512((void const*)(rh + cmp_size - 64)));
+}
+
+static cat_target("sse2") size_t cat_memory_internal_mismatch_sse2(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    uint32_t diff = 0;
+    size_t i = 0;
+    if (cmp_size < 16)
+        return cat_memory_internal_mismatch_scalar(p_block_lh, p_block_rh, cmp_size);
+    for (; i + 16 <= cmp_size; i += 16)
+    {
+        diff = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i)), _mm_loadu_si128((__m128i const*)(rh + i)))) & 0xFFFF;
+        if (diff)
+            return i + cat_memory_internal_ctz64(diff);
+    }
+    i = cmp_size - 16;
+    diff = ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(lh + i)), _mm_loadu_si128((__m128i const*)(rh + i)))) & 0xFFFF;
+    return (diff ? i + cat_memory_internal_ctz64(diff) : cmp_size);
+}
+
+static cat_target("sse2") void cat_memory_internal_hash_sse2(uint64_t* const acc, uint8_t const* const p_data, size_t const stripe_count, uint64_t const* const key)
+{
+    __m128i a[4], k[4], d, dk;
+    __m128i const prime = _mm_set1_epi32((int)CAT_MEMORY_PRIME32_1);
+    size_t s = 0;
+    uint32_t i = 0;
+    for (i = 0; i < 4; ++i)
+    {
+        a[i] = _mm_loadu_si128((__m128i const*)(acc + 2 * i));
+        k[i] = _mm_loadu_si128((__m128i const*)(key + 2 * i));
+    }
+    for (s = 0; s < stripe_count; ++s)
+    {
+        for (i = 0; i < 4; ++i)
+        {
+            d = _mm_loadu_si128((__m128i const*)(p_data + s * CAT_MEMORY_HASH_STRIPE + i * 16));
+            dk = _mm_xor_si128(d, k[i]);
+            a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+            a[i] = _mm_add_epi64(a[i], _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32)));
+        }
+        if ((s + 1) % CAT_MEMORY_HASH_SCRAMBLE == 0)
+        {
+            for (i = 0; i < 4; ++i)
+            {
+                d = _mm_xor_si128(_mm_xor_si128(a[i], _mm_srli_epi64(a[i], 47)), k[i]);
+                a[i] = _mm_add_epi64(_mm_mul_epu32(d, prime), _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(d, 32), prime), 32));
+            }
+        }
+    }
+    for (i = 0; i < 4; ++i)
+        _mm_storeu_si128((__m128i*)(acc + 2 * i), a[i]);
+}
+
+static cat_target("avx2") size_t cat_memory_internal_mismatch_avx2(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    uint32_t diff = 0;
+    size_t i = 0;
+    if (cmp_size < 32)
+        return cat_memory_internal_mismatch_sse2(p_block_lh, p_block_rh, cmp_size);
+    for (; i + 32 <= cmp_size; i += 32)
+    {
+        diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i)), _mm256_loadu_si256((__m256i const*)(rh + i))));
+        if (diff)
+            return i + cat_memory_internal_ctz64(diff);
+    }
+    i = cmp_size - 32;
+    diff = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(lh + i)), _mm256_loadu_si256((__m256i const*)(rh + i))));
+    return (diff ? i + cat_memory_internal_ctz64(diff) : cmp_size);
+}
+
+static cat_target("avx2") void cat_memory_internal_hash_avx2(uint64_t* const acc, uint8_t const* const p_data, size_t const stripe_count, uint64_t const* const key)
+{
+    __m256i a[2], k[2], d, dk;
+    __m256i const prime = _mm256_set1_epi32((int)CAT_MEMORY_PRIME32_1);
+    size_t s = 0;
+    uint32_t i = 0;
+    for (i = 0; i < 2; ++i)
+    {
+        a[i] = _mm256_loadu_si256((__m256i const*)(acc + 4 * i));
+        k[i] = _mm256_loadu_si256((__m256i const*)(key + 4 * i));
+    }
+    for (s = 0; s < stripe_count; ++s)
+    {
+        for (i = 0; i < 2; ++i)
+        {
+            d = _mm256_loadu_si256((__m256i const*)(p_data + s * CAT_MEMORY_HASH_STRIPE + i * 32));
+            dk = _mm256_xor_si256(d, k[i]);
+            a[i] = _mm256_add_epi64(a[i], _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+            a[i] = _mm256_add_epi64(a[i], _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32)));
+        }
+        if ((s + 1) % CAT_MEMORY_HASH_SCRAMBLE == 0)
+        {
+            for (i = 0; i < 2; ++i)
+            {
+                d = _mm256_xor_si256(_mm256_xor_si256(a[i], _mm256_srli_epi64(a[i], 47)), k[i]);
+                a[i] = _mm256_add_epi64(_mm256_mul_epu32(d, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(d, 32), prime), 32));
+            }
+        }
+    }
+    for (i = 0; i < 2; ++i)
+        _mm256_storeu_si256((__m256i*)(acc + 4 * i), a[i]);
+}
+
+static cat_target("avx512f,avx512bw") size_t cat_memory_internal_mismatch_avx512(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    uint64_t diff = 0;
+    size_t i = 0;
+    if (cmp_size < 64)
+        return cat_memory_internal_mismatch_avx2(p_block_lh, p_block_rh, cmp_size);
+    for (; i + 64 <= cmp_size; i += 64)
+    {
+        diff = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i)), _mm512_loadu_si512((void const*)(rh + i)));
+        if (diff)
+            return i + cat_memory_internal_ctz64(diff);
+    }
+    i = cmp_size - 64;
+    diff = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512((void const*)(lh + i)), _mm512_loadu_si512((void const*)(rh + i)));
+    return (diff ? i + cat_memory_internal_ctz64(diff) : cmp_size);
+}
+
+static cat_target("avx512f,avx512bw") void cat_memory_internal_hash_avx512(uint64_t* const acc, uint8_t const* const p_data, size_t const stripe_count, uint64_t const* const key)
+{
+    __m512i a = _mm512_loadu_si512((void const*)acc), d, dk;
+    __m512i const k = _mm512_loadu_si512((void const*)key);
+    __m512i const prime = _mm512_set1_epi32((int)CAT_MEMORY_PRIME32_1);
+    size_t s = 0;
+    for (s = 0; s < stripe_count; ++s)
+    {
+        d = _mm512_loadu_si512((void const*)(p_data + s * CAT_MEMORY_HASH_STRIPE));
+        dk = _mm512_xor_si512(d, k);
+        a = _mm512_add_epi64(a, _mm512_shuffle_epi32(d, (_MM_PERM_ENUM)_MM_SHUFFLE(1, 0, 3, 2)));
+        a = _mm512_add_epi64(a, _mm512_mul_epu32(dk, _mm512_srli_epi64(dk, 32)));
+        if ((s + 1) % CAT_MEMORY_HASH_SCRAMBLE == 0)
+        {
+            d = _mm512_xor_si512(_mm512_xor_si512(a, _mm512_srli_epi64(a, 47)), k);
+            a = _mm512_add_epi64(_mm512_mul_epu32(d, prime), _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(d, 32), prime), 32));
+        }
+    }
+    _mm512_storeu_si512((void*)acc, a);
+}
+
+static cat_memory_simd_t cat_memory_internal_simd_detect(void)
+{
+    // instruction support alone is not enough: system must also save wide registers on context switch
+#ifdef _WIN32
+    int info[4] = { 0 };
+    uint64_t xcr0 = 0;
+    bool avx2 = false, avx512 = false;
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return cat_memory_simd_sse2;
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)))
+        return cat_memory_simd_sse2;
+    xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    avx2 = ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6);
+    avx512 = ((info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xE6) == 0xE6);
+    return (avx512 ? cat_memory_simd_avx512 : avx2 ? cat_memory_simd_avx2 : cat_memory_simd_sse2);
+#else // #ifdef _WIN32
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return cat_memory_simd_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return cat_memory_simd_avx2;
+    return (__builtin_cpu_supports("sse2") ? cat_memory_simd_sse2 : cat_memory_simd_none);
+#endif // #else // #ifdef _WIN32
+}
+#endif // #ifdef CAT_MEMORY_SIMD_X86
+
+static void cat_memory_internal_simd_select(cat_memory_simd_t const simd)
+{
+    memoryKernels.simd = simd;
+    memoryKernels.memset = &cat_memory_internal_memset_libc;
+    memoryKernels.memcpy = &cat_memory_internal_memcpy_libc;
+    memoryKernels.memcmp = &cat_memory_internal_memcmp_libc;
+    memoryKernels.mismatch = &cat_memory_internal_mismatch_scalar;
+    memoryKernels.hash = &cat_memory_internal_hash_scalar;
+#ifdef CAT_MEMORY_SIMD_X86
+    switch (simd)
+    {
+    case cat_memory_simd_sse2:
+        memoryKernels.memset = &cat_memory_internal_memset_sse2;
+        memoryKernels.memcpy = &cat_memory_internal_memcpy_sse2;
+        memoryKernels.memcmp = &cat_memory_internal_memcmp_sse2;
+        memoryKernels.mismatch = &cat_memory_internal_mismatch_sse2;
+        memoryKernels.hash = &cat_memory_internal_hash_sse2;
+        break;
+    case cat_memory_simd_avx2:
+        memoryKernels.memset = &cat_memory_internal_memset_avx2;
+        memoryKernels.memcpy = &cat_memory_internal_memcpy_avx2;
+        memoryKernels.memcmp = &cat_memory_internal_memcmp_avx2;
+        memoryKernels.mismatch = &cat_memory_internal_mismatch_avx2;
+        memoryKernels.hash = &cat_memory_internal_hash_avx2;
+        break;
+    case cat_memory_simd_avx512:
+        memoryKernels.memset = &cat_memory_internal_memset_avx512;
+        memoryKernels.memcpy = &cat_memory_internal_memcpy_avx512;
+        memoryKernels.memcmp = &cat_memory_internal_memcmp_avx512;
+        memoryKernels.mismatch = &cat_memory_internal_mismatch_avx512;
+        memoryKernels.hash = &cat_memory_internal_hash_avx512;
+        break;
+    default:
+        break;
+    }
+#endif // #ifdef CAT_MEMORY_SIMD_X86
+}
+
+static void cat_memory_internal_simd_init(void)
+{
+#ifdef CAT_MEMORY_SIMD_X86
+    memoryKernels.supported = cat_memory_internal_simd_detect();
+#else // #ifdef CAT_MEMORY_SIMD_X86
+    memoryKernels.supported = cat_memory_simd_none;
+#endif // #else // #ifdef CAT_MEMORY_SIMD_X86
+    cat_memory_internal_simd_select(memoryKernels.supported);
+}
+
+cat_impl cat_memory_simd_t cat_memory_simd_supported(void)
+{
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    return memoryKernels.supported;
+}
+
+cat_impl cat_memory_simd_t cat_memory_simd(void)
+{
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    return memoryKernels.simd;
+}
+
+cat_impl bool cat_memory_set_simd(cat_memory_simd_t const simd)
+{
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    assert_or_bail(simd <= memoryKernels.supported) false;
+    cat_memory_internal_simd_select(simd);
+    return true;
+}
+
+cat_impl void* cat_memset(void* const p_block, uint8_t const value, size_t const set_size)
+{
+    assert_or_bail(p_block) NULL;
+    assert_or_bail(set_size) NULL;
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    memoryKernels.memset(p_block, value, set_size);
+    return p_block;
+}
+
+cat_impl void* cat_memclr(void* const p_block, size_t const clr_size)
+{
+    return cat_memset(p_block, 0, clr_size);
+}
+
+cat_impl void* cat_memcpy(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+{
+    assert_or_bail(p_block_dst) NULL;
+    assert_or_bail(p_block_src) NULL;
+    assert_or_bail(cpy_size) NULL;
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    memoryKernels.memcpy(p_block_dst, p_block_src, cpy_size);
+    return p_block_dst;
+}
+
+cat_impl bool cat_memcmp(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+{
+    assert_or_bail(p_block_lh) false;
+    assert_or_bail(p_block_rh) false;
+    assert_or_bail(cmp_size) false;
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    return memoryKernels.memcmp(p_block_lh, p_block_rh, cmp_size);
+}
+
+cat_impl int cat_memory_compare(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size, size_t* const p_offset_out)
+{
+    uint8_t const* const lh = (uint8_t const*)p_block_lh, * const rh = (uint8_t const*)p_block_rh;
+    size_t offset = 0;
+    assert_or_bail(p_block_lh) 0;
+    assert_or_bail(p_block_rh) 0;
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    offset = (cmp_size ? memoryKernels.mismatch(p_block_lh, p_block_rh, cmp_size) : 0);
+    if (p_offset_out)
+        *p_offset_out = offset;
+    return (offset == cmp_size ? 0 : lh[offset] < rh[offset] ? -1 : 1);
+}
+
+cat_impl uint64_t cat_memory_hash(void const* const p_block, size_t const hash_size, uint64_t const seed)
+{
+    // lanes and key derive from seed; short blocks are mixed word by word, long blocks by stripes with last stripe overlapping
+    uint8_t const* const p_data = (uint8_t const*)p_block;
+    uint64_t acc[CAT_MEMORY_HASH_LANES], key[CAT_MEMORY_HASH_LANES];
+    uint64_t result = seed ^ (hash_size * CAT_MEMORY_PRIME64_1), word = 0;
+    size_t i = 0;
+    assert_or_bail(p_block || !hash_size) 0;
+    for (i = 0; i < CAT_MEMORY_HASH_LANES; ++i)
+    {
+        key[i] = cat_memory_internal_fmix64(seed + (i + 1) * CAT_MEMORY_PRIME64_2);
+        acc[i] = key[i] ^ CAT_MEMORY_PRIME64_1;
+    }
+    if (hash_size < CAT_MEMORY_HASH_STRIPE)
+    {
+        for (i = 0; i + 8 <= hash_size; i += 8)
+            result = cat_memory_internal_rotl64(result ^ cat_memory_internal_fmix64(cat_memory_internal_read64(p_data + i) ^ key[i / 8]), 27) * CAT_MEMORY_PRIME64_1;
+        for (word = 0; i < hash_size; ++i)
+            word |= (uint64_t)p_data[i] << (8 * (i % 8));
+        if (hash_size % 8)
+            result = cat_memory_internal_rotl64(result ^ cat_memory_internal_fmix64(word ^ key[7]), 27) * CAT_MEMORY_PRIME64_1;
+        return cat_memory_internal_fmix64(result);
+    }
+    call_once(&memoryKernelsOnce, &cat_memory_internal_simd_init);
+    memoryKernels.hash(acc, p_data, (hash_size - 1) / CAT_MEMORY_HASH_STRIPE, key);
+    cat_memory_internal_hash_scalar(acc, p_data + hash_size - CAT_MEMORY_HASH_STRIPE, 1, key);
+    for (i = 0; i < CAT_MEMORY_HASH_LANES; ++i)
+        result = cat_memory_internal_rotl64(result ^ cat_memory_internal_fmix64(acc[i] + key[i]), 31) * CAT_MEMORY_PRIME64_1;
+    return cat_memory_internal_fmix64(result);
+}
+
+static cat_memory_guard_t memoryGuard;
+static once_flag memoryGuardOnce = ONCE_FLAG_INIT;
+static _Thread_local uint32_t memoryGuardCountdown, memoryGuardSeed;
+
+static void cat_memory_internal_guard_init(void)
+{
+    bool const result = (mtx_init(&memoryGuard.lock, mtx_plain) == thrd_success);
+    assert_or_unused(result);
+}
+
+static bool cat_memory_internal_guard_owns(void const* const p_block)
+{
+    // single compare on every release while no region exists
+    return ((size_t)((uint8_t const*)p_block - memoryGuard.p_region) < memoryGuard.region_size);
+}
+
+static uint8_t* cat_memory_internal_guard_page(uint32_t const slot)
+{
+    return memoryGuard.p_region + (2 * (size_t)slot + 1) * CAT_MEMORY_PAGE_SIZE;
+}
+
+static bool cat_memory_internal_guard_protect(uint32_t const slot, bool const access)
+{
+#ifdef _WIN32
+    DWORD protect_prev = 0;
+    return (VirtualProtect(cat_memory_internal_guard_page(slot), CAT_MEMORY_PAGE_SIZE, access ? PAGE_READWRITE : PAGE_NOACCESS, &protect_prev) != FALSE);
+#else // #ifdef _WIN32
+    return (mprotect(cat_memory_internal_guard_page(slot), CAT_MEMORY_PAGE_SIZE, access ? (PROT_READ | PROT_WRITE) : PROT_NONE) == 0);
+#endif // #else // #ifdef _WIN32
+}
+
+static size_t cat_memory_internal_guard_append(char* const buffer, size_t const buffer_size, size_t length, char const* const text)
+{
+    // async-signal-safe: no library formatting, buffer stays terminated
+    char const* p_text = text;
+    while (*p_text && length + 1 < buffer_size)
+        buffer[length++] = *p_text++;
+    buffer[length] = 0;
+    return length;
+}
+
+static size_t cat_memory_internal_guard_append_number(char* const buffer, size_t const buffer_size, size_t const length, char const* const prefix, uint64_t value, uint32_t const base)
+{
+    char digits[24];
+    size_t i = sizeof(digits) - 1;
+    digits[i] = 0;
+    do
+    {
+        digits[--i] = "0123456789abcdef"[value % base];
+        value /= base;
+    } while (value && i);
+    return cat_memory_internal_guard_append(buffer, buffer_size, cat_memory_internal_guard_append(buffer, buffer_size, length, prefix), digits + i);
+}
+
+static int cat_memory_internal_guard_describe(char* const buffer, size_t const buffer_size, void const* const p_address)
+{
+    // nearest slot to faulting address: its own page, or guard page shared with neighbour on whichever side is closer;
+    // formatted by hand because fault handler calls this
+    size_t const offset = (size_t)((uint8_t const*)p_address - memoryGuard.p_region);
+    size_t const page = offset / CAT_MEMORY_PAGE_SIZE;
+    uint32_t slot = (uint32_t)(page / 2);
+    cat_memory_guard_slot_t const* p_slot = NULL;
+    char const* kind = NULL;
+    ptrdiff_t distance = 0;
+    size_t length = 0;
+    if (!cat_memory_internal_guard_owns(p_address) || !buffer_size)
+        return 0;
+    if (!(page % 2) && (slot == memoryGuard.slot_count || (offset % CAT_MEMORY_PAGE_SIZE) < CAT_MEMORY_PAGE_SIZE / 2) && slot)
+        --slot;
+    slot = (slot < memoryGuard.slot_count ? slot : memoryGuard.slot_count - 1);
+    p_slot = &memoryGuard.p_slot[slot];
+    if (!p_slot->p_block)
+    {
+        length = cat_memory_internal_guard_append_number(buffer, buffer_size, 0, "\nGuarded access: 0x", (uint64_t)(size_t)p_address, 16);
+        return (int)cat_memory_internal_guard_append(buffer, buffer_size, length, " is in guard region next to unused slot");
+    }
+    if (!p_slot->live)
+        kind = "use after release";
+    else if ((uint8_t const*)p_address >= p_slot->p_block + p_slot->size)
+        kind = "overflow";
+    else if ((uint8_t const*)p_address < p_slot->p_block)
+        kind = "underflow";
+    else
+        kind = "access";
+    distance = (uint8_t const*)p_address - p_slot->p_block;
+    length = cat_memory_internal_guard_append(buffer, buffer_size, 0, "\nGuarded ");
+    length = cat_memory_internal_guard_append(buffer, buffer_size, length, kind);
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, ": 0x", (uint64_t)(size_t)p_address, 16);
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, (distance < 0 ? " is -" : " is +"), (uint64_t)(distance < 0 ? -distance : distance), 10);
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, " bytes from ", (uint64_t)p_slot->size, 10);
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, "-byte block 0x", (uint64_t)(size_t)p_slot->p_block, 16);
+    length = cat_memory_internal_guard_append(buffer, buffer_size, length, " allocated at ");
+    length = cat_memory_internal_guard_append(buffer, buffer_size, length, p_slot->file ? p_slot->file : "?");
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, "(", (uint64_t)p_slot->line, 10);
+    length = cat_memory_internal_guard_append_number(buffer, buffer_size, length, "), caller 0x", (uint64_t)(size_t)p_slot->p_caller, 16);
+    return (int)length;
+}
+
+#ifdef _WIN32
+static LONG CALLBACK cat_memory_internal_guard_handler(EXCEPTION_POINTERS* const p_exception)
+{
+    // report and let fault continue to crash handling
+    char buffer[512];
+    EXCEPTION_RECORD const* const p_record = p_exception->ExceptionRecord;
+    if (p_record->ExceptionCode == EXCEPTION_ACCESS_VIOLATION && p_record->NumberParameters >= 2 &&
+        cat_memory_internal_guard_describe(buffer, sizeof(buffer), (void const*)p_record->ExceptionInformation[1]) > 0)
+    {
+        fputs(buffer, stderr);
+        fflush(stderr);
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+#else // #ifdef _WIN32
+static void cat_memory_internal_guard_handler(int const signal_number, siginfo_t* const p_info, void* const p_context)
+{
+    // fault in guard region: report, put previous handler back and return so faulting access repeats under it;
+    // any other fault goes straight to previous handler, which stays chained behind this one
+    char buffer[512];
+    struct sigaction const* const p_prev = &memoryGuard.handler_prev;
+    int const length = cat_memory_internal_guard_describe(buffer, sizeof(buffer), p_info->si_addr);
+    ssize_t written = 0;
+    if (length > 0)
+    {
+        written = write(STDERR_FILENO, buffer, (size_t)length);
+        unused(written);
+        sigaction(SIGSEGV, p_prev, NULL);
+    }
+    else if ((p_prev->sa_flags & SA_SIGINFO) && p_prev->sa_sigaction)
+        p_prev->sa_sigaction(signal_number, p_info, p_context);
+    else if (p_prev->sa_handler == SIG_DFL)
+    {
+        // default action terminates once fault repeats, or once handler returns if signal was sent
+        sigaction(SIGSEGV, p_prev, NULL);
+        raise(signal_number);
+    }
+    else if (p_prev->sa_handler != SIG_IGN)
+        p_prev->sa_handler(signal_number);
+}
+#endif // #else // #ifdef _WIN32
+
+static uint32_t cat_memory_internal_guard_random(void)
+{
+    // per-thread xorshift; seeded from hashed thread-local address so threads draw different sequences
+    memoryGuardSeed = (memoryGuardSeed ? memoryGuardSeed : (uint32_t)(((uint64_t)(size_t)&memoryGuardSeed * 0x9E3779B97F4A7C15ull) >> 32) | 1);
+    memoryGuardSeed ^= memoryGuardSeed << 13;
+    memoryGuardSeed ^= memoryGuardSeed >> 17;
+    memoryGuardSeed ^= memoryGuardSeed << 5;
+    return memoryGuardSeed;
+}
+
+static bool cat_memory_internal_guard_sample(size_t const block_size)
+{
+    // random countdown with mean of sample rate so periodic allocation patterns are not missed or always hit
+    uint32_t const sample_rate = memoryGuard.sample_rate;
+    if (!sample_rate || block_size > CAT_MEMORY_PAGE_SIZE || !block_size)
+        return false;
+    // first eligible allocation on thread starts partway into interval, so new threads do not each take slot at once
+    if (!memoryGuardSeed && sample_rate > 1)
+        memoryGuardCountdown = cat_memory_internal_guard_random() % sample_rate + 1;
+    if (memoryGuardCountdown)
+    {
+        --memoryGuardCountdown;
+        return false;
+    }
+    memoryGuardCountdown = (sample_rate > 1 ? cat_memory_internal_guard_random() % (2 * sample_rate - 1) : 0);
+    return true;
+}
+
+static void* cat_memory_internal_guard_alloc(size_t const block_size, void const* const p_caller, char const* const file, uint32_t const line)
+{
+    // block ends exactly at end of slot page so even one byte overflow faults; it is aligned only as far as its size needs,
+    // largest power of two dividing size up to default alignment, since object fitting in block needs no more
+    size_t const size_align = (block_size & (0 - block_size));
+    size_t const align = (size_align < CAT_MEMORY_GUARD_ALIGN ? size_align : CAT_MEMORY_GUARD_ALIGN);
+    cat_memory_guard_slot_t* p_slot = NULL;
+    uint32_t i = 0, slot = 0;
+    call_once(&memoryGuardOnce, &cat_memory_internal_guard_init);
+    mtx_lock(&memoryGuard.lock);
+    for (i = 0; memoryGuard.p_region && i < memoryGuard.slot_count && !p_slot; ++i)
+    {
+        slot = (memoryGuard.slot_next + i) % memoryGuard.slot_count;
+        if (!memoryGuard.p_slot[slot].live && cat_memory_internal_guard_protect(slot, true))
+            p_slot = &memoryGuard.p_slot[slot];
+    }
+    if (p_slot)
+    {
+        memoryGuard.slot_next = (slot + 1) % memoryGuard.slot_count;
+        p_slot->p_block = cat_memory_internal_guard_page(slot) + ((CAT_MEMORY_PAGE_SIZE - block_size) & ~(align - 1));
+        p_slot->size = block_size;
+        p_slot->p_caller = p_caller;
+        p_slot->file = file;
+        p_slot->line = line;
+        p_slot->live = true;
+        ++memoryGuard.live;
+        ++memoryGuard.sampled;
+    }
+    mtx_unlock(&memoryGuard.lock);
+    return (p_slot ? p_slot->p_block : NULL);
+}
+
+static size_t cat_memory_internal_guard_size(void const* const p_block)
+{
+    return memoryGuard.p_slot[(size_t)((uint8_t const*)p_block - memoryGuard.p_region) / (2 * CAT_MEMORY_PAGE_SIZE)].size;
+}
+
+static bool cat_memory_internal_guard_dealloc(void* const p_block)
+{
+    // page becomes inaccessible so later use faults as use after release
+    char buffer[512];
+    uint32_t const slot = (uint32_t)((size_t)((uint8_t*)p_block - memoryGuard.p_region) / (2 * CAT_MEMORY_PAGE_SIZE));
+    cat_memory_guard_slot_t* const p_slot = &memoryGuard.p_slot[slot < memoryGuard.slot_count ? slot : 0];
+    bool result = false;
+    mtx_lock(&memoryGuard.lock);
+    result = (slot < memoryGuard.slot_count && p_slot->live && p_slot->p_block == (uint8_t*)p_block);
+    if (result)
+    {
+        cat_memory_internal_guard_protect(slot, false);
+        p_slot->live = false;
+        --memoryGuard.live;
+    }
+    else if (cat_memory_internal_guard_describe(buffer, sizeof(buffer), p_block) > 0)
+        fprintf(stderr, "\nGuarded release of invalid or released block:%s", buffer);
+    mtx_unlock(&memoryGuard.lock);
+    return result;
+}
+
+cat_impl bool cat_memory_guard_enable(uint32_t const sample_rate, uint32_t const slot_count)
+{
+    uint32_t const slots = (slot_count ? slot_count : CAT_MEMORY_GUARD_SLOTS);
+    size_t const region_size = (2 * (size_t)slots + 1) * CAT_MEMORY_PAGE_SIZE;
+    cat_memory_guard_slot_t* p_slot = NULL;
+    void* p_region = NULL;
+    bool result = true;
+#ifndef _WIN32
+    struct sigaction handler;
+#endif // #ifndef _WIN32
+    call_once(&memoryGuardOnce, &cat_memory_internal_guard_init);
+    mtx_lock(&memoryGuard.lock);
+
+    // region is kept while guarded blocks are live, so enabling again only changes rate
+    if (!memoryGuard.p_region)
+    {
+        p_slot = (cat_memory_guard_slot_t*)calloc(slots, sizeof(cat_memory_guard_slot_t));
+#ifdef _WIN32
+        p_region = VirtualAlloc(NULL, region_size, MEM_RESERVE | MEM_COMMIT, PAGE_NOACCESS);
+        memoryGuard.p_handler = (p_region && p_slot ? AddVectoredExceptionHandler(1, &cat_memory_internal_guard_handler) : NULL);
+        result = (memoryGuard.p_handler != NULL);
+        if (!result && p_region)
+            VirtualFree(p_region, 0, MEM_RELEASE);
+#else // #ifdef _WIN32
+        p_region = mmap(NULL, region_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        p_region = (p_region != MAP_FAILED ? p_region : NULL);
+        memset(&handler, 0, sizeof(handler));
+        handler.sa_sigaction = &cat_memory_internal_guard_handler;
+        handler.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&handler.sa_mask);
+        result = (p_region && p_slot && sigaction(SIGSEGV, &handler, &memoryGuard.handler_prev) == 0);
+        if (!result && p_region)
+            munmap(p_region, region_size);
+#endif // #else // #ifdef _WIN32
+        if (result)
+        {
+            memoryGuard.p_slot = p_slot;
+            memoryGuard.slot_count = slots;
+            memoryGuard.slot_next = 0;
+            memoryGuard.sampled = 0;
+            memoryGuard.region_size = region_size;
+            memoryGuard.p_region = (uint8_t*)p_region;
+        }
+        else
+            free(p_slot);
+    }
+    memoryGuard.sample_rate = (result ? (sample_rate ? sample_rate : CAT_MEMORY_GUARD_SAMPLE_RATE) : 0);
+    mtx_unlock(&memoryGuard.lock);
+    return result;
+}
+
+cat_impl bool cat_memory_guard_disable(void)
+{
+    bool result = false;
+    call_once(&memoryGuardOnce, &cat_memory_internal_guard_init);
+    mtx_lock(&memoryGuard.lock);
+    memoryGuard.sample_rate = 0;
+
+    // live guarded blocks keep region until they are released and this is called again
+    result = !memoryGuard.live;
+    if (result && memoryGuard.p_region)
+    {
+#ifdef _WIN32
+        RemoveVectoredExceptionHandler(memoryGuard.p_handler);
+        VirtualFree(memoryGuard.p_region, 0, MEM_RELEASE);
+#else // #ifdef _WIN32
+        sigaction(SIGSEGV, &memoryGuard.handler_prev, NULL);
+        munmap(memoryGuard.p_region, memoryGuard.region_size);
+#endif // #else // #ifdef _WIN32
+        free(memoryGuard.p_slot);
+        memoryGuard.p_slot = NULL;
+        memoryGuard.slot_count = 0;
+        memoryGuard.region_size = 0;
+        memoryGuard.p_region = NULL;
+    }
+    mtx_unlock(&memoryGuard.lock);
+    return result;
+}
+
+cat_impl bool cat_memory_guard_owns(void const* const p_block)
+{
+    return cat_memory_internal_guard_owns(p_block);
+}
+
+cat_impl uint32_t cat_memory_guard_sampled(void)
+{
+    return memoryGuard.sampled;
+}
+
+static void* cat_malloc_internal_alloc(size_t const block_size, bool const clear, void const* const p_caller, char const* const file, uint32_t const line)
+{
+    void* const p_block = (cat_memory_internal_guard_sample(block_size) ? cat_memory_internal_guard_alloc(block_size, p_caller, file, line) : NULL);
+    if (!p_block)
+        return (clear ? calloc(1, block_size) : malloc(block_size));
+    return (clear ? memset(p_block, 0, block_size) : p_block);
+}
+
+static void* cat_malloc_internal_realloc(void* const p_block, size_t const block_size)
+{
+    // guarded block moves to heap, it is never resized in its slot
+    size_t size = 0;
+    void* p_block_new = NULL;
+    if (!cat_memory_internal_guard_owns(p_block))
+        return realloc(p_block, block_size);
+    size = cat_memory_internal_guard_size(p_block);
+    p_block_new = malloc(block_size);
+    if (p_block_new)
+    {
+        memcpy(p_block_new, p_block, size < block_size ? size : block_size);
+        cat_memory_internal_guard_dealloc(p_block);
+    }
+    return p_block_new;
+}
+
+static void cat_malloc_internal_free(void* const p_block)
+{
+    if (cat_memory_internal_guard_owns(p_block))
+        cat_memory_internal_guard_dealloc(p_block);
+    else
+        free(p_block);
+}
+
+#ifdef CAT_DEBUG
+static cat_malloc_tracker_t mallocTracker;
+static once_flag mallocTrackerOnce = ONCE_FLAG_INIT;
+
+static void cat_malloc_internal_tracker_init(void)
+{
+    bool const result = (mtx_init(&mallocTracker.lock, mtx_plain) == thrd_success);
+    assert_or_unused(result);
+}
+
+static size_t cat_malloc_internal_tracker_hash(void const* const p_block, size_t const capacity)
+{
+    // discard alignment bits and mix; capacity is power of two
+    uint64_t key = (uint64_t)(uintptr_t)p_block >> 4;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return (size_t)key & (capacity - 1);
+}
+
+static void cat_malloc_internal_tracker_place(cat_malloc_metadata_t* const p_slot, size_t const capacity, cat_malloc_metadata_t const* const p_meta)
+{
+    size_t i = cat_malloc_internal_tracker_hash(p_meta->p_block, capacity);
+    while (p_slot[i].p_block)
+        i = (i + 1) & (capacity - 1);
+    p_slot[i] = *p_meta;
+}
+
+static bool cat_malloc_internal_tracker_grow(void)
+{
+    // keep load at most half so probes stay short
+    size_t const capacity = (mallocTracker.capacity ? mallocTracker.capacity * 2 : CAT_MALLOC_TRACKER_MIN);
+    cat_malloc_metadata_t* const p_slot = (cat_malloc_metadata_t*)calloc(capacity, sizeof(cat_malloc_metadata_t));
+    size_t i = 0;
+    if (!p_slot)
+        return false;
+    for (i = 0; i < mallocTracker.capacity; ++i)
+        if (mallocTracker.p_slot[i].p_block)
+            cat_malloc_internal_tracker_place(p_slot, capacity, &mallocTracker.p_slot[i]);
+    free(mallocTracker.p_slot);
+    mallocTracker.p_slot = p_slot;
+    mallocTracker.capacity = capacity;
+    return true;
+}
+
+static void cat_malloc_internal_track(void* const p_block, size_t const block_size, cat_malloc_mode_t const mode, char const* const file, uint32_t const line)
+{
+    cat_malloc_metadata_t meta;
+    call_once(&mallocTrackerOnce, &cat_malloc_internal_tracker_init);
+    mtx_lock(&mallocTracker.lock);
+    meta.p_block = p_block;
+    meta.file = (file ? file : "?");
+    meta.size = block_size;
+    meta.line = line;
+    meta.sequence = mallocTracker.sequence++;
+    meta.mode = mode;
+    meta.reserved = 0;
+    if ((mallocTracker.count + 1) * 2 > mallocTracker.capacity && !cat_malloc_internal_tracker_grow() && mallocTracker.count + 1 >= mallocTracker.capacity)
+        mallocTracker.overflow = true;
+    else
+    {
+        cat_malloc_internal_tracker_place(mallocTracker.p_slot, mallocTracker.capacity, &meta);
+        ++mallocTracker.count;
+    }
+    mtx_unlock(&mallocTracker.lock);
+}
+
+static bool cat_malloc_internal_untrack(void const* const p_block, cat_malloc_metadata_t* const p_meta_out)
+{
+    // backward-shift deletion: move later entries of the probe run into the hole, so no tombstones
+    cat_malloc_metadata_t* p_slot = NULL;
+    size_t mask = 0, i = 0, j = 0, home = 0;
+    bool result = false;
+    call_once(&mallocTrackerOnce, &cat_malloc_internal_tracker_init);
+    mtx_lock(&mallocTracker.lock);
+    // table may have been regrown by another thread, so read its shape only under lock
+    p_slot = mallocTracker.p_slot;
+    mask = mallocTracker.capacity - 1;
+    if (mallocTracker.capacity)
+    {
+        i = cat_malloc_internal_tracker_hash(p_block, mallocTracker.capacity);
+        while (p_slot[i].p_block && p_slot[i].p_block != p_block)
+            i = (i + 1) & mask;
+        result = (p_slot[i].p_block == p_block);
+    }
+    if (result)
+    {
+        if (p_meta_out)
+            *p_meta_out = p_slot[i];
+        for (j = (i + 1) & mask; p_slot[j].p_block; j = (j + 1) & mask)
+        {
+            home = cat_malloc_internal_tracker_hash(p_slot[j].p_block, mallocTracker.capacity);
+            if (((j - home) & mask) >= ((j - i) & mask))
+            {
+                p_slot[i] = p_slot[j];
+                i = j;
+            }
+        }
+        p_slot[i].p_block = NULL;
+        --mallocTracker.count;
+    }
+    else
+    {
+        result = mallocTracker.overflow;
+        if (p_meta_out)
+            memset(p_meta_out, 0, sizeof(*p_meta_out));
+    }
+    mtx_unlock(&mallocTracker.lock);
+    return result;
+}
+
+cat_impl void* cat_malloc_dbg(size_t const block_size, char const* const file, uint32_t const line)
+{
+    void* p_block = NULL;
+    assert_or_bail(block_size) NULL;
+    p_block = cat_malloc_internal_alloc(block_size, false, cat_memory_caller(), file, line);
+    if (p_block)
+        cat_malloc_internal_track(p_block, block_size, cat_malloc_mode_malloc, file, line);
+    return p_block;
+}
+
+cat_impl void* cat_calloc_dbg(size_t const element_count, size_t const element_size, char const* const file, uint32_t const line)
+{
+    void* p_block = NULL;
+    assert_or_bail(element_count) NULL;
+    assert_or_bail(element_size) NULL;
+    assert_or_bail(element_count <= SIZE_MAX / element_size) NULL;
+    p_block = cat_malloc_internal_alloc(element_count * element_size, true, cat_memory_caller(), file, line);
+    if (p_block)
+        cat_malloc_internal_track(p_block, element_count * element_size, cat_malloc_mode_calloc, file, line);
+    return p_block;
+}
+
+cat_impl void* cat_realloc_dbg(void* const p_block, size_t const block_size, char const* const file, uint32_t const line)
+{
+    // untrack first so a concurrent allocation reusing the old address cannot collide; restore if realloc fails
+    cat_malloc_metadata_t meta;
+    void* p_block_new = NULL;
+    bool result = false;
+    assert_or_bail(p_block) NULL;
+    assert_or_bail(block_size) NULL;
+    result = cat_malloc_internal_untrack(p_block, &meta);
+    assert_or_bail(result) NULL;
+    p_block_new = cat_malloc_internal_realloc(p_block, block_size);
+    if (p_block_new)
+        cat_malloc_internal_track(p_block_new, block_size, cat_malloc_mode_realloc, file, line);
+    else if (meta.p_block)
+        cat_malloc_internal_track(p_block, meta.size, meta.mode, meta.file, meta.line);
+    return p_block_new;
+}
+
+cat_impl size_t cat_malloc_report(bool const print)
+{
+    static char const* const modes[] = { "malloc", "calloc", "realloc" };
+    cat_malloc_metadata_t const* p_meta = NULL;
+    size_t i = 0, count = 0, bytes = 0;
+    call_once(&mallocTrackerOnce, &cat_malloc_internal_tracker_init);
+    mtx_lock(&mallocTracker.lock);
+    count = mallocTracker.count;
+    for (i = 0; i < mallocTracker.capacity; ++i)
+        bytes += (mallocTracker.p_slot[i].p_block ? mallocTracker.p_slot[i].size : 0);
+    if (print)
+    {
+        printf("\nMalloc report: %zu live blocks, %zu bytes%s", count, bytes, mallocTracker.overflow ? " (some untracked)" : "");
+        for (i = 0; i < mallocTracker.capacity; ++i)
+        {
+            p_meta = &mallocTracker.p_slot[i];
+            if (p_meta->p_block)
+                printf("\n    %s(%"PRIu32"): %zu bytes by %s, allocation #%"PRIu32, p_meta->file, p_meta->line, p_meta->size, modes[p_meta->mode], p_meta->sequence);
+        }
+    }
+    mtx_unlock(&mallocTracker.lock);
+    return count;
+}
+#else // #ifdef CAT_DEBUG
+cat_impl size_t cat_malloc_report(bool const print)
+{
+    unused(print);
+    return 0;
+}
+#endif // #else // #ifdef CAT_DEBUG
+
+cat_impl void* (cat_malloc)(size_t const block_size)
+{
+#ifdef CAT_DEBUG
+    return cat_malloc_dbg(block_size, NULL, 0);
+#else // #ifdef CAT_DEBUG
+    assert_or_bail(block_size) NULL;
+    return cat_malloc_internal_alloc(block_size, false, cat_memory_caller(), NULL, 0);
+#endif // #else // #ifdef CAT_DEBUG
+}
+
+cat_impl void* (cat_calloc)(size_t const element_count, size_t const element_size)
+{
+#ifdef CAT_DEBUG
+    return cat_calloc_dbg(element_count, element_size, NULL, 0);
+#else // #ifdef CAT_DEBUG
+    assert_or_bail(element_count) NULL;
+    assert_or_bail(element_size) NULL;
+    assert_or_bail(element_count <= SIZE_MAX / element_size) NULL;
+    return cat_malloc_internal_alloc(element_count * element_size, true, cat_memory_caller(), NULL, 0);
+#endif // #else // #ifdef CAT_DEBUG
+}
+
+cat_impl void* (cat_realloc)(void* const p_block, size_t const block_size)
+{
+#ifdef CAT_DEBUG
+    return cat_realloc_dbg(p_block, block_size, NULL, 0);
+#else // #ifdef CAT_DEBUG
+    assert_or_bail(p_block) NULL;
+    assert_or_bail(block_size) NULL;
+    return cat_malloc_internal_realloc(p_block, block_size);
+#endif // #else // #ifdef CAT_DEBUG
+}
+
+cat_impl void cat_free(void* const p_block)
+{
+#ifdef CAT_DEBUG
+    bool result = false;
+#endif // #ifdef CAT_DEBUG
+    assert_or_bail(p_block);
+#ifdef CAT_DEBUG
+    // untracked block is a double free or was not allocated here
+    result = cat_malloc_internal_untrack(p_block, NULL);
+    assert_or_bail(result);
+#endif // #ifdef CAT_DEBUG
+    cat_malloc_internal_free(p_block);
+}
+
+cat_impl void* cat_malloc_aligned(size_t const block_size, size_t const block_align)
+{
+    void* p_block = NULL;
+    assert_or_bail(block_size) NULL;
+    assert_or_bail(block_align && !(block_align & (block_align - 1))) NULL;
+#ifdef _WIN32
+    p_block = _aligned_malloc(block_size, block_align);
+#else // #ifdef _WIN32
+    // size must be multiple of alignment, which must be at least pointer size
+    p_block = aligned_alloc(block_align > sizeof(void*) ? block_align : sizeof(void*), cat_memory_internal_align(block_size, block_align));
+#endif // #else // #ifdef _WIN32
+    return p_block;
+}
+
+cat_impl void cat_free_aligned(void* const p_block)
+{
+    assert_or_bail(p_block);
+#ifdef _WIN32
+    _aligned_free(p_block);
+#else // #ifdef _WIN32
+    free(p_block);
+#endif // #else // #ifdef _WIN32
+}
+
+#ifndef _WIN32
+static void cat_memory_internal_pool_bind(void* const p_map, size_t const map_size)
+{
+    // bind to node of calling processor, moving pages already populated; on failure pages stay wherever first touched
+#if (defined SYS_getcpu && defined SYS_mbind)
+    unsigned long mask[4] = { 0 };
+    unsigned int cpu = 0, node = 0;
+    int const policy_bind = 2, flag_move = 2;// MPOL_BIND, MPOL_MF_MOVE
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0 || node >= sizeof(mask) * 8)
+        return;
+    mask[node / (sizeof(mask[0]) * 8)] = 1ul << (node % (sizeof(mask[0]) * 8));
+    syscall(SYS_mbind, p_map, map_size, policy_bind, mask, sizeof(mask) * 8, flag_move);
+#endif // #if (defined SYS_getcpu && defined SYS_mbind)
+}
+#endif // #ifndef _WIN32
+
+static bool cat_memory_internal_pool_reserve(cat_memory_pool_t* const p_pool, size_t const pool_size)
+{
+    // heap block unless a mapping flag is set; mapped pool is address space only until pages are touched
+#ifdef _WIN32
+    if (p_pool->flags & CAT_MEMORY_POOL_FLAG_MAPPED)
+    {
+        // commit charge is taken up front but pages are still zero-filled on first touch; large pages need privilege so are not used
+        if (p_pool->flags & cat_memory_pool_flag_node_local)
+        {
+            PROCESSOR_NUMBER processor = { 0 };
+            USHORT node = 0;
+            GetCurrentProcessorNumberEx(&processor);
+            if (GetNumaProcessorNodeEx(&processor, &node) && node != (USHORT)(-1))
+                p_pool->p_memory = VirtualAllocExNuma(GetCurrentProcess(), NULL, pool_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+        }
+        if (!p_pool->p_memory)
+            p_pool->p_memory = VirtualAlloc(NULL, pool_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        p_pool->map_size = (p_pool->p_memory ? pool_size : 0);
+    }
+    else
+        p_pool->p_memory = malloc(pool_size);
+#else // #ifdef _WIN32
+    void* p_map = MAP_FAILED;
+    size_t map_size = 0, head = 0;
+    int const populate = ((p_pool->flags & cat_memory_pool_flag_prefault) ? MAP_POPULATE : 0);
+    if (p_pool->flags & CAT_MEMORY_POOL_FLAG_MAPPED)
+    {
+        // explicit huge pages come from reserved hugetlbfs pool; without NORESERVE a short pool fails here rather than with SIGBUS on touch,
+        // and transparent huge pages are used instead
+        if (p_pool->flags & cat_memory_pool_flag_huge_tlb)
+        {
+            map_size = cat_memory_internal_align(pool_size, CAT_MEMORY_HUGE_PAGE_SIZE);
+            p_map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate, -1, 0);
+        }
+        if (p_map == MAP_FAILED && (p_pool->flags & (cat_memory_pool_flag_huge_pages | cat_memory_pool_flag_huge_tlb)))
+        {
+            // over-reserve so huge page boundary can be kept, then trim both ends
+            map_size = cat_memory_internal_align(pool_size, CAT_MEMORY_HUGE_PAGE_SIZE);
+            p_map = mmap(NULL, map_size + CAT_MEMORY_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p_map != MAP_FAILED)
+            {
+                head = cat_memory_internal_align((size_t)p_map, CAT_MEMORY_HUGE_PAGE_SIZE) - (size_t)p_map;
+                if (head)
+                    munmap(p_map, head);
+                munmap((uint8_t*)p_map + head + map_size, CAT_MEMORY_HUGE_PAGE_SIZE - head);
+                p_map = (uint8_t*)p_map + head;
+                madvise(p_map, map_size, MADV_HUGEPAGE);
+                for (head = 0; populate && head < map_size; head += CAT_MEMORY_PAGE_SIZE)
+                    ((uint8_t volatile*)p_map)[head] = 0;
+            }
+        }
+        if (p_map == MAP_FAILED)
+        {
+            map_size = pool_size;
+            p_map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | populate, -1, 0);
+        }
+        if (p_map != MAP_FAILED && (p_pool->flags & cat_memory_pool_flag_node_local))
+            cat_memory_internal_pool_bind(p_map, map_size);
+        p_pool->p_memory = (p_map != MAP_FAILED ? p_map : NULL);
+        p_pool->map_size = (p_map != MAP_FAILED ? map_size : 0);
+    }
+    else
+        p_pool->p_memory = malloc(pool_size);
+#endif // #else // #ifdef _WIN32
+    return (p_pool->p_memory != NULL);
+}
+
+static void cat_memory_internal_pool_release(cat_memory_pool_t* const p_pool)
+{
+#ifdef _WIN32
+    if (p_pool->map_size)
+        VirtualFree(p_pool->p_memory, 0, MEM_RELEASE);
+#else // #ifdef _WIN32
+    if (p_pool->map_size)
+        munmap(p_pool->p_memory, p_pool->map_size);
+#endif // #else // #ifdef _WIN32
+    else
+        free(p_pool->p_memory);
+    p_pool->p_memory = NULL;
+    p_pool->map_size = 0;
+}
+
+cat_impl bool cat_memory_pool_init_desc(cat_memory_pool_t* const p_pool, cat_memory_pool_desc_t const* const p_desc)
+{
+    size_t offset = 0, slab_share = 0;
+    uint32_t i = 0, lock_count = 0;
+    bool result = true;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_desc && p_desc->size) false;
+    memset(p_pool, 0, sizeof(*p_pool));
+    p_pool->policy = p_desc->policy;
+    p_pool->flags = p_desc->flags;
+    p_pool->backend = p_desc->backend;
+
+    // reserve pool and align first block
+    if (!cat_memory_internal_pool_reserve(p_pool, p_desc->size))
+        return false;
+    offset = cat_memory_internal_align((size_t)p_pool->p_memory, CAT_MEMORY_ALIGN) - (size_t)p_pool->p_memory;
+    if (p_desc->size < offset + CAT_MEMORY_BLOCK_MIN)
+    {
+        cat_memory_internal_pool_release(p_pool);
+        return false;
+    }
+    p_pool->size = (p_desc->size - offset) & ~(CAT_MEMORY_ALIGN - 1);
+
+    // front share of pool holds slab descriptors followed by page-aligned slab pages
+    slab_share = p_pool->size / CAT_MEMORY_SLAB_FRACTION;
+    p_pool->p_slab_table = (cat_memory_slab_t*)((uint8_t*)p_pool->p_memory + offset);
+    p_pool->slab_count = (uint32_t)(slab_share / (CAT_MEMORY_SLAB_SIZE + sizeof(cat_memory_slab_t)));
+    p_pool->p_slab_begin = (uint8_t*)cat_memory_internal_align((size_t)(p_pool->p_slab_table + p_pool->slab_count), CAT_MEMORY_SLAB_SIZE);
+    while (p_pool->slab_count && (p_pool->p_slab_begin + p_pool->slab_count * CAT_MEMORY_SLAB_SIZE > (uint8_t*)p_pool->p_slab_table + slab_share))
+        p_pool->p_slab_begin = (uint8_t*)cat_memory_internal_align((size_t)(p_pool->p_slab_table + --p_pool->slab_count), CAT_MEMORY_SLAB_SIZE);
+    if (!p_pool->slab_count)
+        p_pool->p_slab_begin = (uint8_t*)p_pool->p_slab_table;
+    p_pool->p_slab_end = p_pool->p_slab_begin + p_pool->slab_count * CAT_MEMORY_SLAB_SIZE;
+
+    // remainder of pool starts as one free block
+    p_pool->p_begin = (cat_memory_block_t*)p_pool->p_slab_end;
+    p_pool->p_end = (cat_memory_block_t*)((uint8_t*)p_pool->p_slab_table + p_pool->size);
+    p_pool->p_begin->size = (size_t)((uint8_t*)p_pool->p_end - (uint8_t*)p_pool->p_begin);
+    p_pool->p_begin->p_prev_phys = NULL;
+    if (p_pool->backend == cat_memory_backend_buddy)
+    {
+        if (!cat_memory_internal_buddy_init(p_pool))
+        {
+            cat_memory_internal_pool_release(p_pool);
+            memset(p_pool, 0, sizeof(*p_pool));
+            return false;
+        }
+    }
+    else
+        cat_memory_internal_free_push(p_pool, (cat_memory_free_block_t*)p_pool->p_begin);
+
+    // concurrent pool: lock for general blocks and pages, lock per class, cache per thread
+    if (cat_memory_internal_concurrent(p_pool))
+    {
+        result = (mtx_init(&p_pool->lock, mtx_plain) == thrd_success);
+        lock_count += result;
+        for (i = 0; result && i < CAT_MEMORY_SLAB_CLASSES; ++i)
+        {
+            result = (mtx_init(&p_pool->slab_class[i].lock, mtx_plain) == thrd_success);
+            lock_count += result;
+        }
+        if (result)
+            result = (tss_create(&p_pool->cache_key, &cat_memory_internal_cache_release) == thrd_success);
+        if (!result)
+        {
+            // only destroy what was created: pool lock first, then class locks
+            if (lock_count)
+                mtx_destroy(&p_pool->lock);
+            for (i = 1; i < lock_count; ++i)
+                mtx_destroy(&p_pool->slab_class[i - 1].lock);
+            cat_memory_internal_pool_release(p_pool);
+            memset(p_pool, 0, sizeof(*p_pool));
+        }
+    }
+    return result;
+}
+
+cat_impl bool cat_memory_pool_init(cat_memory_pool_t* const p_pool, size_t const pool_size)
+{
+    cat_memory_pool_desc_t const desc = { pool_size, cat_memory_policy_first_fit, 0, cat_memory_backend_free_list };
+    return cat_memory_pool_init_desc(p_pool, &desc);
+}
+
+cat_impl bool cat_memory_pool_term(cat_memory_pool_t* const p_pool)
+{
+    cat_memory_cache_t* p_cache = NULL;
+    uint32_t i = 0;
+    assert_or_bail(p_pool) false;
+    if (p_pool->p_memory != NULL)
+    {
+        // other threads using pool must have exited; their caches were released on exit
+        if (cat_memory_internal_concurrent(p_pool))
+        {
+            p_cache = (cat_memory_cache_t*)tss_get(p_pool->cache_key);
+            if (p_cache)
+                cat_memory_internal_cache_release(p_cache);
+            tss_delete(p_pool->cache_key);
+            for (i = 0; i < CAT_MEMORY_SLAB_CLASSES; ++i)
+                mtx_destroy(&p_pool->slab_class[i].lock);
+            mtx_destroy(&p_pool->lock);
+        }
+        cat_memory_internal_pool_release(p_pool);
+        memset(p_pool, 0, sizeof(*p_pool));
+        return true;
+    }
+
+    return false;
+}
+
+cat_impl bool cat_memory_pool_flush(cat_memory_pool_t* const p_pool)
+{
+    cat_memory_cache_t* p_cache = NULL;
+    uint32_t i = 0;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_pool->p_memory) false;
+    if (cat_memory_internal_concurrent(p_pool))
+    {
+        p_cache = (cat_memory_cache_t*)tss_get(p_pool->cache_key);
+        for (i = 0; p_cache && i < CAT_MEMORY_SLAB_CLASSES; ++i)
+            cat_memory_internal_cache_flush(p_cache, i, p_cache->count[i]);
+    }
+    return true;
+}
+
+cat_impl bool cat_memory_pool_set_policy(cat_memory_pool_t* const p_pool, cat_memory_policy_t const policy)
+{
+    assert_or_bail(p_pool) false;
+    assert_or_bail(policy == cat_memory_policy_first_fit || policy == cat_memory_policy_best_fit) false;
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    p_pool->policy = policy;
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    return true;
+}
+
+cat_impl bool cat_memory_pool_fragmentation(cat_memory_pool_t* const p_pool, double* const p_internal_out, double* const p_external_out)
 {
-#ifdef _WIN32
-    //****TO-DO-MEMORY: fill in this structure.
-    struct cat_malloc_metadata_s* p_prev;
-    struct cat_malloc_metadata_s* p_next;
-    char* file;
-    uint32_t line;
-    uint32_t mode;
-    size_t size;
-    uint32_t sequence;
-    uint32_t reserved;
-#else // #ifdef _WIN32
-    uint32_t reserved;
-#endif // #else // #ifdef _WIN32
-} cat_malloc_metadata_t;
-#endif // #ifdef CAT_DEBUG
+    size_t free = 0, largest = 0;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_pool->p_memory) false;
+    assert_or_bail(p_internal_out && p_external_out) false;
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    cat_memory_internal_free_extent(p_pool, &free, &largest);
+    *p_internal_out = (p_pool->reserved_total ? 1.0 - (double)p_pool->requested_total / (double)p_pool->reserved_total : 0.0);
+    *p_external_out = (free ? 1.0 - (double)largest / (double)free : 0.0);
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    return true;
+}
 
-static void* memoryPool;
-static size_t poolSize, memoryUsed;
-static uint32_t blockNum;
-static cat_malloc_metadata_t* head = NULL;
+cat_impl bool cat_memory_pool_stats(cat_memory_pool_t* const p_pool, cat_memory_pool_stats_t* const p_stats_out)
+{
+    // class locks before pool lock, same order as allocation
+    size_t free = 0;
+    uint32_t i = 0;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_pool->p_memory) false;
+    assert_or_bail(p_stats_out) false;
+    memset(p_stats_out, 0, sizeof(*p_stats_out));
+    for (i = 0; i < CAT_MEMORY_SLAB_CLASSES; ++i)
+        cat_memory_internal_lock(p_pool, &p_pool->slab_class[i].lock);
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    for (i = 0; i < CAT_MEMORY_SLAB_CLASSES; ++i)
+    {
+        p_stats_out->live_blocks += p_pool->slab_class[i].live;
+        p_stats_out->histogram[cat_memory_internal_histogram_bin(CAT_MEMORY_SLAB_MIN << i)] += p_pool->slab_class[i].live;
+    }
+    for (i = 0; i < CAT_MEMORY_HISTOGRAM_BINS; ++i)
+        p_stats_out->histogram[i] += p_pool->histogram[i];
+    p_stats_out->live_blocks += p_pool->block_count;
+    p_stats_out->capacity = p_pool->slab_count * CAT_MEMORY_SLAB_SIZE + (size_t)((uint8_t*)p_pool->p_end - (uint8_t*)p_pool->p_begin);
+    p_stats_out->in_use = cat_memory_internal_in_use(p_pool);
+    p_stats_out->peak = p_pool->peak;
+    cat_memory_internal_free_extent(p_pool, &free, &p_stats_out->largest_free);
+    p_stats_out->fragmentation = (free ? 1.0 - (double)p_stats_out->largest_free / (double)free : 0.0);
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    for (i = CAT_MEMORY_SLAB_CLASSES; i > 0; --i)
+        cat_memory_internal_unlock(p_pool, &p_pool->slab_class[i - 1].lock);
+    return true;
+}
 
-cat_impl void* cat_memset(void* const p_block, uint8_t const value, size_t const set_size)
+#ifndef _WIN32
+static bool cat_memory_internal_snapshot_file(cat_memory_pool_snapshot_t* const p_snapshot, cat_memory_pool_t const* const p_pool)
 {
-    assert_or_bail(p_block) NULL;
-    assert_or_bail(set_size) NULL;
-    return memset(p_block, value, set_size);
+    // untouched pages read as zero so only resident runs are written and rest of file stays a hole
+    size_t const page_count = (p_pool->map_size + CAT_MEMORY_PAGE_SIZE - 1) / CAT_MEMORY_PAGE_SIZE;
+    uint8_t const* const p_memory = (uint8_t const*)p_pool->p_memory;
+    unsigned char* p_resident = NULL;
+    size_t page = 0, run = 0, offset = 0, end = 0;
+    ssize_t written = 0;
+    int const file = memfd_create("cat_memory_snapshot", MFD_CLOEXEC);
+    bool result = (file >= 0) && (ftruncate(file, (off_t)p_pool->map_size) == 0);
+    p_resident = (result ? (unsigned char*)malloc(page_count) : NULL);
+    result = result && p_resident && (mincore(p_pool->p_memory, p_pool->map_size, p_resident) == 0);
+    for (page = 0; result && page < page_count; page += run)
+    {
+        for (run = 1; page + run < page_count && (p_resident[page + run] & 1) == (p_resident[page] & 1); ++run);
+        if (!(p_resident[page] & 1))
+            continue;
+        offset = page * CAT_MEMORY_PAGE_SIZE;
+        end = (page + run) * CAT_MEMORY_PAGE_SIZE;
+        end = (end < p_pool->map_size ? end : p_pool->map_size);
+        while (result && offset < end)
+        {
+            written = pwrite(file, p_memory + offset, end - offset, (off_t)offset);
+            result = (written > 0);
+            offset += (result ? (size_t)written : 0);
+        }
+    }
+    free(p_resident);
+    if (!result && file >= 0)
+        close(file);
+    p_snapshot->image_file = (result ? file : -1);
+    p_snapshot->image_size = (result ? p_pool->map_size : 0);
+    return result;
 }
+#endif // #ifndef _WIN32
 
-cat_impl void* cat_memclr(void* const p_block, size_t const clr_size)
+cat_impl bool cat_memory_pool_snapshot(cat_memory_pool_t* const p_pool, cat_memory_pool_snapshot_t* const p_snapshot_out)
 {
-    return cat_memset(p_block, 0xFF, clr_size);
+    cat_memory_free_block_t const* p_free = NULL;
+    uint8_t* p_general_end = NULL;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_pool->p_memory) false;
+    assert_or_bail(p_snapshot_out) false;
+    assert_or_bail(!cat_memory_internal_concurrent(p_pool)) false;
+    memset(p_snapshot_out, 0, sizeof(*p_snapshot_out));
+    p_snapshot_out->p_pool = p_pool;
+    p_snapshot_out->state = *p_pool;
+    p_snapshot_out->image_file = -1;
+
+    // mapped pool is saved to memory file so restore remaps it copy-on-write and only pages written afterwards are copied;
+    // remapping would drop huge page advice and node binding set up at init, so those pools and other systems take plain copy of managed range
+#ifndef _WIN32
+    if (p_pool->map_size && !(p_pool->flags & (cat_memory_pool_flag_huge_pages | cat_memory_pool_flag_huge_tlb | cat_memory_pool_flag_node_local))
+        && cat_memory_internal_snapshot_file(p_snapshot_out, p_pool))
+        return true;
+#endif // #ifndef _WIN32
+
+    // copy skips slab pages never used and payload of free block at end of pool, neither of which allocator reads before writing
+    p_general_end = (uint8_t*)p_pool->p_end;
+    if (p_pool->backend == cat_memory_backend_free_list)
+    {
+        for (p_free = p_pool->p_free_head; p_free; p_free = p_free->p_next)
+        {
+            if ((uint8_t*)p_free + cat_memory_internal_block_size(&p_free->block) == (uint8_t*)p_pool->p_end)
+            {
+                p_general_end = (uint8_t*)p_free + CAT_MEMORY_BLOCK_MIN;
+                break;
+            }
+        }
+    }
+    p_snapshot_out->slab_size = (size_t)(p_pool->p_slab_begin + p_pool->slab_bump * CAT_MEMORY_SLAB_SIZE - (uint8_t*)p_pool->p_slab_table);
+    p_snapshot_out->image_size = p_snapshot_out->slab_size + (size_t)(p_general_end - (uint8_t*)p_pool->p_begin);
+    p_snapshot_out->p_image = cat_malloc(p_snapshot_out->image_size);
+    if (!p_snapshot_out->p_image)
+    {
+        memset(p_snapshot_out, 0, sizeof(*p_snapshot_out));
+        p_snapshot_out->image_file = -1;
+        return false;
+    }
+    cat_memcpy(p_snapshot_out->p_image, p_pool->p_slab_table, p_snapshot_out->slab_size);
+    cat_memcpy((uint8_t*)p_snapshot_out->p_image + p_snapshot_out->slab_size, p_pool->p_begin, p_snapshot_out->image_size - p_snapshot_out->slab_size);
+    return true;
 }
 
-cat_impl void* cat_memcpy(void* const p_block_dst, void const* const p_block_src, size_t const cpy_size)
+cat_impl bool cat_memory_pool_restore(cat_memory_pool_t* const p_pool, cat_memory_pool_snapshot_t const* const p_snapshot)
 {
-    assert_or_bail(p_block_dst) NULL;
-    assert_or_bail(p_block_src) NULL;
-    assert_or_bail(cpy_size) NULL;
-    return memcpy(p_block_dst, p_block_src, cpy_size);
+#ifndef _WIN32
+    int const populate = ((p_pool && (p_pool->flags & cat_memory_pool_flag_prefault)) ? MAP_POPULATE : 0);
+#endif // #ifndef _WIN32
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_snapshot && p_snapshot->p_pool == p_pool) false;
+    assert_or_bail(p_pool->p_memory && p_pool->p_memory == p_snapshot->state.p_memory) false;
+    assert_or_bail(p_snapshot->p_image || p_snapshot->image_file >= 0) false;
+#ifndef _WIN32
+    if (p_snapshot->image_file >= 0)
+    {
+        // replacing mapping drops every page dirtied since capture in one call
+        if (mmap(p_pool->p_memory, p_snapshot->image_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | populate, p_snapshot->image_file, 0) == MAP_FAILED)
+            return false;
+    }
+    else
+#endif // #ifndef _WIN32
+    {
+        cat_memcpy(p_pool->p_slab_table, p_snapshot->p_image, p_snapshot->slab_size);
+        cat_memcpy(p_pool->p_begin, (uint8_t const*)p_snapshot->p_image + p_snapshot->slab_size, p_snapshot->image_size - p_snapshot->slab_size);
+    }
+
+    // all allocator pointers refer into pool memory, which is back at same address, so state is taken whole
+    *p_pool = p_snapshot->state;
+    return true;
 }
 
-cat_impl bool cat_memcmp(void const* const p_block_lh, void const* const p_block_rh, size_t const cmp_size)
+cat_impl bool cat_memory_pool_snapshot_release(cat_memory_pool_snapshot_t* const p_snapshot)
 {
-    assert_or_bail(p_block_lh) false;
-    assert_or_bail(p_block_rh) false;
-    assert_or_bail(cmp_size) false;
-    return (memcmp(p_block_lh, p_block_rh, cmp_size) == 0);
+    assert_or_bail(p_snapshot) false;
+#ifndef _WIN32
+    if (p_snapshot->image_file >= 0)
+        close(p_snapshot->image_file);
+#endif // #ifndef _WIN32
+    if (p_snapshot->p_image)
+        cat_free(p_snapshot->p_image);
+    memset(p_snapshot, 0, sizeof(*p_snapshot));
+    p_snapshot->image_file = -1;
+    return true;
 }
 
-cat_impl void* cat_malloc(size_t const block_size)
+cat_impl void* cat_memory_pool_alloc_aligned(cat_memory_pool_t* const p_pool, size_t const block_size, size_t const block_align)
 {
-#ifdef CAT_DEBUG
-    cat_malloc_metadata_t* p_meta = NULL;
-#endif // #ifdef CAT_DEBUG
     void* p_block = NULL;
+    size_t const align = (block_align > CAT_MEMORY_ALIGN ? block_align : CAT_MEMORY_ALIGN);
+    size_t const class_size = (block_size > align ? block_size : align);
+    uint32_t size_class = 0;
+    assert_or_bail(p_pool) NULL;
     assert_or_bail(block_size) NULL;
-    p_block = malloc(block_size);
-#ifdef CAT_DEBUG
-    unused(p_meta);
-#endif // #ifdef CAT_DEBUG
+    assert_or_bail(block_align && !(block_align & (block_align - 1))) NULL;
+    assert_or_bail(p_pool->p_memory) NULL;
+
+    // small blocks from thread cache or size class slabs; slab objects are aligned to class size
+    if (class_size <= CAT_MEMORY_SLAB_MAX && p_pool->slab_count)
+    {
+        size_class = cat_memory_internal_slab_class(class_size);
+        if (cat_memory_internal_concurrent(p_pool))
+            p_block = cat_memory_internal_cache_alloc(p_pool, size_class);
+        else
+            p_block = cat_memory_internal_slab_alloc(p_pool, size_class);
+    }
+
+    // general blocks otherwise or if slabs exhausted
+    if (!p_block)
+    {
+        cat_memory_internal_lock(p_pool, &p_pool->lock);
+        p_block = cat_memory_internal_general_alloc(p_pool, block_size, align);
+        cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    }
     return p_block;
 }
 
-cat_impl void* cat_calloc(size_t const element_count, size_t const element_size)
+cat_impl void* cat_memory_pool_alloc(cat_memory_pool_t* const p_pool, size_t const block_size)
 {
-#ifdef CAT_DEBUG
-    cat_malloc_metadata_t* p_meta = NULL;
-#endif // #ifdef CAT_DEBUG
-    void* p_block = NULL;
-    assert_or_bail(element_count) NULL;
-    assert_or_bail(element_size) NULL;
-    p_block = calloc(element_count, element_size);
-#ifdef CAT_DEBUG
-    unused(p_meta);
-#endif // #ifdef CAT_DEBUG
-    return p_block;
+    return cat_memory_pool_alloc_aligned(p_pool, block_size, CAT_MEMORY_ALIGN);
 }
 
-cat_impl void* cat_realloc(void* const p_block, size_t const block_size)
+cat_impl bool cat_memory_pool_dealloc(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    bool result = false;
+    assert_or_bail(p_pool) false;
+    assert_or_bail(p_block) false;
+    assert_or_bail(p_pool->p_memory) false;
+
+    // slab region is checked by address alone; class of live object is stable without lock
+    if ((uint8_t*)p_block >= p_pool->p_slab_begin && (uint8_t*)p_block < p_pool->p_slab_end)
+    {
+        if (cat_memory_internal_concurrent(p_pool))
+            return cat_memory_internal_cache_dealloc(p_pool, p_block, cat_memory_internal_slab_owner(p_pool, p_block)->size_class);
+        return cat_memory_internal_slab_dealloc(p_pool, p_block);
+    }
+
+    cat_memory_internal_lock(p_pool, &p_pool->lock);
+    result = cat_memory_internal_general_dealloc(p_pool, p_block);
+    cat_memory_internal_unlock(p_pool, &p_pool->lock);
+    return result;
+}
+
+cat_impl void* cat_memory_pool_realloc_aligned(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size, size_t const block_align)
 {
-#ifdef CAT_DEBUG
-    cat_malloc_metadata_t* p_meta = NULL;
-#endif // #ifdef CAT_DEBUG
     void* p_block_new = NULL;
-    assert_or_bail(p_block) NULL;
+    size_t usable = 0;
+    bool result = false;
+    assert_or_bail(p_pool) NULL;
     assert_or_bail(block_size) NULL;
-    p_block_new = realloc(p_block, block_size);
-#ifdef CAT_DEBUG
-    unused(p_meta);
-#endif // #ifdef CAT_DEBUG
+    assert_or_bail(block_align && !(block_align & (block_align - 1))) NULL;
+    assert_or_bail(p_pool->p_memory) NULL;
+    assert_or_bail(!((size_t)p_block & (block_align - 1))) NULL;
+    if (!p_block)
+        return cat_memory_pool_alloc_aligned(p_pool, block_size, block_align);
+
+    // slab object stays if size still fits its class; general block grows or shrinks in place if neighbours allow
+    if ((uint8_t*)p_block >= p_pool->p_slab_begin && (uint8_t*)p_block < p_pool->p_slab_end)
+    {
+        usable = (CAT_MEMORY_SLAB_MIN << cat_memory_internal_slab_owner(p_pool, p_block)->size_class);
+        result = (block_size <= usable);
+    }
+    else
+    {
+        cat_memory_internal_lock(p_pool, &p_pool->lock);
+        usable = (cat_memory_internal_general_owns(p_pool, p_block) ? cat_memory_internal_general_size(p_pool, p_block) : 0);
+        if (p_pool->backend != cat_memory_backend_buddy && usable)
+            usable -= sizeof(cat_memory_block_t);
+        result = (usable && cat_memory_internal_general_realloc(p_pool, p_block, block_size));
+        cat_memory_internal_unlock(p_pool, &p_pool->lock);
+        assert_or_bail(usable) NULL;
+    }
+    if (result)
+        return p_block;
+
+    // move as last resort with same alignment; original block is kept if pool is exhausted
+    p_block_new = cat_memory_pool_alloc_aligned(p_pool, block_size, block_align);
+    if (!p_block_new)
+        return NULL;
+    memcpy(p_block_new, p_block, (usable < block_size ? usable : block_size));
+    cat_memory_pool_dealloc(p_pool, p_block);
     return p_block_new;
 }
 
-cat_impl void cat_free(void* const p_block)
+cat_impl void* cat_memory_pool_realloc(cat_memory_pool_t* const p_pool, void* const p_block, size_t const block_size)
 {
-#ifdef CAT_DEBUG
-    cat_malloc_metadata_t* p_meta = NULL;
-#endif // #ifdef CAT_DEBUG
-    assert_or_bail(p_block);
-#ifdef CAT_DEBUG
-    unused(p_meta);
-#endif // #ifdef CAT_DEBUG
-    free(p_block);
+    return cat_memory_pool_realloc_aligned(p_pool, p_block, block_size, CAT_MEMORY_ALIGN);
 }
 
 cat_impl bool cat_memory_pool_create(size_t const pool_size)
 {
-    assert_or_bail(pool_size) false;
+    assert_or_bail(!memoryDefault.p_memory) false;
+    return cat_memory_pool_init(&memoryDefault, pool_size);
+}
 
-    //****TO-DO-MEMORY: allocate and initialize pool.
+cat_impl bool cat_memory_pool_create_desc(cat_memory_pool_desc_t const* const p_desc)
+{
+    assert_or_bail(!memoryDefault.p_memory) false;
+    return cat_memory_pool_init_desc(&memoryDefault, p_desc);
+}
 
-    poolSize = pool_size;
-    memoryUsed = 0;
-    blockNum = 0;
-    memoryPool = malloc(poolSize);
+cat_impl bool cat_memory_pool_destroy(void)
+{
+    return cat_memory_pool_term(&memoryDefault);
+}
 
-    head = (cat_malloc_metadata_t*)memoryPool;
-    head->p_next = NULL;
-    head->p_prev = NULL;
+cat_impl bool cat_memory_set_policy(cat_memory_policy_t const policy)
+{
+    return cat_memory_pool_set_policy(&memoryDefault, policy);
+}
 
-    if (memoryPool != NULL)
-        return true;
+cat_impl void* cat_memory_realloc_aligned(void* const p_block, size_t const block_size, size_t const block_align)
+{
+    // guarded block moves to pool, it is never resized in its slot
+    size_t size = 0;
+    void* p_block_new = NULL;
+    if (!p_block || !cat_memory_internal_guard_owns(p_block))
+        return cat_memory_pool_realloc_aligned(&memoryDefault, p_block, block_size, block_align);
+    size = cat_memory_internal_guard_size(p_block);
+    p_block_new = cat_memory_pool_alloc_aligned(&memoryDefault, block_size, block_align);
+    if (p_block_new)
+    {
+        cat_memcpy(p_block_new, p_block, size < block_size ? size : block_size);
+        cat_memory_internal_guard_dealloc(p_block);
+    }
+    return p_block_new;
+}
 
-    return false;
+cat_impl void* cat_memory_realloc(void* const p_block, size_t const block_size)
+{
+    return cat_memory_realloc_aligned(p_block, block_size, CAT_MEMORY_ALIGN);
 }
 
-cat_impl bool cat_memory_pool_destroy(void)
+cat_impl bool cat_memory_stats(cat_memory_pool_stats_t* const p_stats_out)
 {
-    //****TO-DO-MEMORY: safely deallocate pool allocated above.
+    return cat_memory_pool_stats(&memoryDefault, p_stats_out);
+}
 
-    if (memoryPool != NULL)
-    {
-        head = NULL;
-        poolSize = 0;
-        free(memoryPool);
+cat_impl void* cat_memory_alloc(size_t const block_size)
+{
+    void* const p_block = ((memoryDefault.p_memory && cat_memory_internal_guard_sample(block_size)) ? cat_memory_internal_guard_alloc(block_size, cat_memory_caller(), NULL, 0) : NULL);
+    return (p_block ? p_block : cat_memory_pool_alloc(&memoryDefault, block_size));
+}
 
-        return true;
-    }
+cat_impl void* cat_memory_alloc_aligned(size_t const block_size, size_t const block_align)
+{
+    return cat_memory_pool_alloc_aligned(&memoryDefault, block_size, block_align);
+}
 
-    return false;
+cat_impl bool cat_memory_dealloc(void* const p_block)
+{
+    if (p_block && cat_memory_internal_guard_owns(p_block))
+        return cat_memory_internal_guard_dealloc(p_block);
+    return cat_memory_pool_dealloc(&memoryDefault, p_block);
 }
 
-cat_impl void* cat_memory_alloc(size_t const block_size)
+cat_impl bool cat_memory_arena_init(cat_memory_arena_t* const p_arena, cat_memory_pool_t* const p_pool, size_t const capacity)
 {
-    assert_or_bail(block_size) NULL;
+    assert_or_bail(p_arena) false;
+    assert_or_bail(capacity) false;
+    p_arena->p_pool = p_pool;
+    p_arena->p_base = (uint8_t*)(p_pool ? cat_memory_pool_alloc(p_pool, capacity) : cat_malloc(capacity));
+    p_arena->capacity = (p_arena->p_base ? capacity : 0);
+    p_arena->offset = 0;
+    return (p_arena->p_base != NULL);
+}
 
-    //****TO-DO-MEMORY: reserve block in managed pool.
+cat_impl bool cat_memory_arena_term(cat_memory_arena_t* const p_arena)
+{
+    assert_or_bail(p_arena) false;
+    assert_or_bail(p_arena->p_base) false;
+    if (p_arena->p_pool)
+        cat_memory_pool_dealloc(p_arena->p_pool, p_arena->p_base);
+    else
+        cat_free(p_arena->p_base);
+    memset(p_arena, 0, sizeof(*p_arena));
+    return true;
+}
 
-    // Check if enough space
-    if (block_size + memoryUsed + sizeof(cat_malloc_metadata_t) > poolSize)
+cat_impl void* cat_memory_arena_alloc(cat_memory_arena_t* const p_arena, size_t const block_size, size_t const block_align)
+{
+    // align absolute address so arena base alignment does not matter
+    size_t offset = 0;
+    assert_or_bail(p_arena) NULL;
+    assert_or_bail(block_size) NULL;
+    assert_or_bail(block_align && !(block_align & (block_align - 1))) NULL;
+    offset = cat_memory_internal_align((size_t)p_arena->p_base + p_arena->offset, block_align) - (size_t)p_arena->p_base;
+    if (offset > p_arena->capacity || block_size > p_arena->capacity - offset)
         return NULL;
+    p_arena->offset = offset + block_size;
+    return (p_arena->p_base + offset);
+}
+
+cat_impl cat_memory_arena_mark_t cat_memory_arena_mark(cat_memory_arena_t const* const p_arena)
+{
+    assert_or_bail(p_arena) 0;
+    return p_arena->offset;
+}
 
-    // Create new block
-    cat_malloc_metadata_t* newBlock = (cat_malloc_metadata_t*)((char*)memoryPool + memoryUsed);
-    
-    // Insert at head of list
-    newBlock->p_prev = NULL;
-    newBlock->p_next = newBlock != head ? head : NULL;
-    newBlock->size = block_size;
-    newBlock->sequence = blockNum++;
+cat_impl bool cat_memory_arena_rewind(cat_memory_arena_t* const p_arena, cat_memory_arena_mark_t const mark)
+{
+    assert_or_bail(p_arena) false;
+    assert_or_bail(mark <= p_arena->offset) false;
+    p_arena->offset = mark;
+    return true;
+}
+
+cat_impl bool cat_memory_arena_reset(cat_memory_arena_t* const p_arena)
+{
+    assert_or_bail(p_arena) false;
+    p_arena->offset = 0;
+    return true;
+}
 
-    if (head != NULL)
-        head->p_prev = newBlock;
-    head = newBlock;
+cat_impl bool cat_memory_scratch_create(size_t const capacity)
+{
+    assert_or_bail(!memoryScratch.p_base) false;
+    return cat_memory_arena_init(&memoryScratch, NULL, capacity);
+}
 
-    memoryUsed += block_size + sizeof(cat_malloc_metadata_t);
+cat_impl bool cat_memory_scratch_destroy(void)
+{
+    return cat_memory_arena_term(&memoryScratch);
+}
 
-    return (void*)(newBlock + 1);
+cat_impl cat_memory_arena_t* cat_memory_scratch(void)
+{
+    return (memoryScratch.p_base ? &memoryScratch : NULL);
 }
 
-cat_impl bool cat_memory_dealloc(void* const p_block)
+cat_impl cat_memory_allocator_t cat_memory_allocator_heap(void)
 {
-    assert_or_bail(p_block) false;
+    cat_memory_allocator_t const allocator = { cat_memory_allocator_kind_heap, 0, NULL };
+    return allocator;
+}
 
-    //****TO-DO-MEMORY: safely release block reserved above.
+cat_impl cat_memory_allocator_t cat_memory_allocator_pool(cat_memory_pool_t* const p_pool)
+{
+    cat_memory_allocator_t const allocator = { cat_memory_allocator_kind_pool, 0, p_pool };
+    assert_or_unused(p_pool);
+    return allocator;
+}
 
-    // Get metadata to dealloc
-    cat_malloc_metadata_t* blockToDealloc = (cat_malloc_metadata_t*)((char*)p_block - sizeof(cat_malloc_metadata_t));
+cat_impl cat_memory_allocator_t cat_memory_allocator_arena(cat_memory_arena_t* const p_arena)
+{
+    cat_memory_allocator_t const allocator = { cat_memory_allocator_kind_arena, 0, p_arena };
+    assert_or_unused(p_arena);
+    return allocator;
+}
 
-    // Resolve block before
-    if (blockToDealloc->p_prev == NULL)
+cat_impl void* cat_memory_allocator_alloc(cat_memory_allocator_t const* const p_allocator, size_t const block_size)
+{
+    assert_or_bail(p_allocator) NULL;
+    switch (p_allocator->kind)
     {
-        head = blockToDealloc->p_next;
+    case cat_memory_allocator_kind_pool:
+        return cat_memory_pool_alloc((cat_memory_pool_t*)p_allocator->p_source, block_size);
+    case cat_memory_allocator_kind_arena:
+        return cat_memory_arena_alloc((cat_memory_arena_t*)p_allocator->p_source, block_size, CAT_MEMORY_ALIGN);
+    default:
+        return cat_malloc(block_size);
     }
-    else
+}
+
+cat_impl void* cat_memory_allocator_realloc(cat_memory_allocator_t const* const p_allocator, void* const p_block, size_t const block_size_old, size_t const block_size)
+{
+    cat_memory_arena_t* p_arena = NULL;
+    void* p_block_new = NULL;
+    assert_or_bail(p_allocator) NULL;
+    assert_or_bail(block_size) NULL;
+    if (!p_block)
+        return cat_memory_allocator_alloc(p_allocator, block_size);
+    switch (p_allocator->kind)
     {
-        blockToDealloc->p_prev->p_next = blockToDealloc->p_next;
+    case cat_memory_allocator_kind_pool:
+        return cat_memory_pool_realloc((cat_memory_pool_t*)p_allocator->p_source, p_block, block_size);
+    case cat_memory_allocator_kind_arena:
+        // most recent block moves arena end; any other block is copied and its space held until rewind
+        p_arena = (cat_memory_arena_t*)p_allocator->p_source;
+        if ((uint8_t*)p_block + block_size_old == p_arena->p_base + p_arena->offset && block_size <= p_arena->capacity - (size_t)((uint8_t*)p_block - p_arena->p_base))
+        {
+            p_arena->offset = (size_t)((uint8_t*)p_block - p_arena->p_base) + block_size;
+            return p_block;
+        }
+        p_block_new = cat_memory_arena_alloc(p_arena, block_size, CAT_MEMORY_ALIGN);
+        if (p_block_new)
+            cat_memcpy(p_block_new, p_block, block_size_old < block_size ? block_size_old : block_size);
+        return p_block_new;
+    default:
+        return cat_realloc(p_block, block_size);
     }
+}
 
-    // Resolve block after
-    if (blockToDealloc->p_next != NULL)
+cat_impl bool cat_memory_allocator_dealloc(cat_memory_allocator_t const* const p_allocator, void* const p_block, size_t const block_size)
+{
+    cat_memory_arena_t* p_arena = NULL;
+    assert_or_bail(p_allocator) false;
+    assert_or_bail(p_block) false;
+    switch (p_allocator->kind)
     {
-        blockToDealloc->p_next->p_prev = blockToDealloc->p_prev;
+    case cat_memory_allocator_kind_pool:
+        return cat_memory_pool_dealloc((cat_memory_pool_t*)p_allocator->p_source, p_block);
+    case cat_memory_allocator_kind_arena:
+        p_arena = (cat_memory_arena_t*)p_allocator->p_source;
+        if ((uint8_t*)p_block + block_size == p_arena->p_base + p_arena->offset)
+            p_arena->offset = (size_t)((uint8_t*)p_block - p_arena->p_base);
+        return true;
+    default:
+        cat_free(p_block);
+        return true;
     }
+}
 
-    memoryUsed -= blockToDealloc->size + sizeof(cat_malloc_metadata_t);
 
-    return true;
-     
+#include "cat/utility/cat_time.h"
+#include "cat/utility/cat_console.h"
+#include "cat/utility/cat_thread.h"
+
 
-    //return false;
+static void cat_memory_test_stats(char const* const label)
+{
+    cat_memory_pool_stats_t stats;
+    uint32_t i = 0;
+    if (!cat_memory_stats(&stats))
+        return;
+    printf("\nPool stats %s: %zu of %zu bytes in use, %zu peak, %"PRIu32" live blocks, largest free %zu, fragmentation %.2f",
+        label, stats.in_use, stats.capacity, stats.peak, stats.live_blocks, stats.largest_free, stats.fragmentation);
+    for (i = 0; i < CAT_MEMORY_HISTOGRAM_BINS; ++i)
+        if (stats.histogram[i])
+            printf("\n    %zu bytes: %"PRIu32" blocks", (size_t)1 << i, stats.histogram[i]);
 }
 
+static int cat_memory_test_thread_func(size_t const argc, void* const argv[])
+{
+    // mixed small alloc/free with a window of live blocks
+    cat_memory_pool_t* p_pool = NULL;
+    void* blocks[32] = { NULL };
+    uint32_t seed = 0, iter = 0, count = 0, i = 0;
+    int result = 0;
+    assert_or_bail((argc == 3) && argv && argv[0] && argv[1] && argv[2]) 1;
+    p_pool = (cat_memory_pool_t*)argv[0];
+    count = *(uint32_t const*)argv[1];
+    seed = *(uint32_t const*)argv[2];
+    for (iter = 0; iter < count; ++iter)
+    {
+        seed = seed * 1664525 + 1013904223;
+        i = (seed >> 8) % array_count(blocks);
+        if (blocks[i])
+            result |= !cat_memory_pool_dealloc(p_pool, blocks[i]);
+        blocks[i] = cat_memory_pool_alloc(p_pool, 8 + (seed >> 16) % 248);
+        result |= (blocks[i] == NULL);
+    }
+    for (i = 0; i < array_count(blocks); ++i)
+        if (blocks[i])
+            result |= !cat_memory_pool_dealloc(p_pool, blocks[i]);
+    return result;
+}
 
-#include "cat/utility/cat_time.h"
-#include "cat/utility/cat_console.h"
+static bool cat_memory_test_concurrent(cat_memory_pool_t* const p_pool, uint32_t const thread_count, uint32_t const count, cat_time_t* const p_time_out)
+{
+    // threads run mixed alloc/free on shared pool; all blocks are back once joined
+    thrd_t thrd[8] = { 0 };
+    uint32_t seed[8] = { 0 };
+    void* args[8][3] = { { NULL } };
+    cat_thread_params_t params[8] = { { NULL } };
+    int thrd_res = 0;
+    uint32_t i = 0, started = 0;
+    cat_time_t t = 0;
+    bool result = true;
+    assert_or_bail(p_pool && thread_count <= array_count(thrd)) false;
+    t = cat_platform_time();
+    for (i = 0; result && i < thread_count; ++i)
+    {
+        seed[i] = i + 1;
+        args[i][0] = p_pool;
+        args[i][1] = (void*)&count;
+        args[i][2] = &seed[i];
+        params[i].func = &cat_memory_test_thread_func;
+        params[i].argc = array_count(args[i]);
+        params[i].argv = args[i];
+        result = (cat_thrd_create(&thrd[i], &params[i]) == thrd_success);
+        started += result;
+    }
+    for (i = 0; i < started; ++i)
+    {
+        thrd_join(thrd[i], &thrd_res);
+        result = result && !thrd_res;
+    }
+    t = cat_platform_time() - t;
+    if (p_time_out)
+        *p_time_out = t;
+    return result && !cat_memory_internal_slab_used(p_pool) && !p_pool->block_count;
+}
 
 
 cat_noinl void cat_memory_test(void)
@@ -251,7 +3203,7 @@ cat_noinl void cat_memory_test(void)
         cat_console_clear();
         cat_memset(block_lh, 0xFF, 1024);
         cat_memclr(block_rh, 2048);
-        result = cat_memcmp(block_lh, block_rh, 2048);
+        result = cat_memcmp(block_lh, block_rh, 1024);
         printf("\nMemory: \n    Blocks are equal: %"PRIi32, (int32_t)result);
         cat_memcpy(block_lh, block_rh, 1024);
         result = cat_memcmp(block_lh, block_rh, 1024);
@@ -264,6 +3216,78 @@ cat_noinl void cat_memory_test(void)
     cat_free(block_rh);
     block_rh = NULL;
 
+    // every supported kernel matches standard library at all sizes and alignments, including streaming sizes; hash is same for all
+    {
+        static size_t const sizes[] = { 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 255, 256, 1000, 4097, CAT_MEMORY_STREAM_SIZE + 77 };
+        size_t const buffer_size = CAT_MEMORY_STREAM_SIZE + 256;
+        uint8_t* const p_src = (uint8_t*)cat_malloc(buffer_size);
+        uint8_t* const p_dst = (uint8_t*)cat_malloc(buffer_size);
+        uint8_t* const p_ref = (uint8_t*)cat_malloc(buffer_size);
+        cat_memory_simd_t const simd = cat_memory_simd();
+        cat_memory_simd_t level = cat_memory_simd_none;
+        uint64_t hashes[array_count(sizes)][4], hash = 0;
+        size_t i = 0, n = 0, offset = 0, flip = 0, at = 0;
+        result = (p_src && p_dst && p_ref);
+        for (i = 0; result && i < buffer_size; ++i)
+            p_src[i] = (uint8_t)(i * 2654435761u >> 13);
+        for (level = cat_memory_simd_none; result && level <= cat_memory_simd_supported(); ++level)
+        {
+            cat_memory_set_simd(level);
+            for (n = 0; result && n < array_count(sizes); ++n)
+            {
+                for (offset = 0; result && offset < 4; ++offset)
+                {
+                    memset(p_dst, 0xA5, buffer_size);
+                    memset(p_ref, 0xA5, buffer_size);
+                    memset(p_ref + offset, 0x3C, sizes[n]);
+                    result = (cat_memset(p_dst + offset, 0x3C, sizes[n]) == p_dst + offset) && !memcmp(p_dst, p_ref, buffer_size);
+                    memcpy(p_ref + offset, p_src + 3 - offset, sizes[n]);
+                    result = result && (cat_memcpy(p_dst + offset, p_src + 3 - offset, sizes[n]) == p_dst + offset) && !memcmp(p_dst, p_ref, buffer_size);
+                    flip = (sizes[n] * 7 + offset) % sizes[n];
+                    result = result && cat_memcmp(p_dst + offset, p_src + 3 - offset, sizes[n]);
+                    result = result && !cat_memory_compare(p_dst + offset, p_src + 3 - offset, sizes[n], &at) && (at == sizes[n]);
+                    p_dst[offset + flip] ^= 0x10;
+                    result = result && !cat_memcmp(p_dst + offset, p_src + 3 - offset, sizes[n]);
+                    result = result && (cat_memory_compare(p_dst + offset, p_src + 3 - offset, sizes[n], &at) == (p_dst[offset + flip] < p_src[3 - offset + flip] ? -1 : 1)) && (at == flip);
+                    hash = cat_memory_hash(p_src + offset, sizes[n], offset);
+                    if (level == cat_memory_simd_none)
+                        hashes[n][offset] = hash;
+                    result = result && (hash == hashes[n][offset]) && (hash != cat_memory_hash(p_dst + offset, sizes[n], offset));
+                }
+            }
+        }
+        cat_memory_set_simd(simd);
+        printf("\nMemory kernels: %s (up to %s)", result ? "Success" : "Failed",
+            cat_memory_simd_supported() == cat_memory_simd_avx512 ? "AVX-512" : cat_memory_simd_supported() == cat_memory_simd_avx2 ? "AVX2" : cat_memory_simd_supported() == cat_memory_simd_sse2 ? "SSE2" : "standard library");
+        if (p_ref)
+            cat_free(p_ref);
+        if (p_dst)
+            cat_free(p_dst);
+        if (p_src)
+            cat_free(p_src);
+    }
+
+#ifdef CAT_DEBUG
+    // tracked blocks: call sites recorded, realloc moves record, free removes it
+    {
+        void* blocks[300] = { NULL };
+        size_t const live = cat_malloc_report(false);
+        uint32_t i = 0;
+        for (i = 0; i < array_count(blocks); ++i)
+            blocks[i] = (i % 2 ? cat_malloc(16 + i) : cat_calloc(4, 8 + i));
+        result = (cat_malloc_report(false) == live + array_count(blocks));
+        for (i = 0; result && i < array_count(blocks); i += 3)
+            result = ((blocks[i] = cat_realloc(blocks[i], 4096)) != NULL);
+        for (i = 0; i < array_count(blocks); i += 2)
+            cat_free(blocks[i]);
+        result = result && (cat_malloc_report(false) == live + array_count(blocks) / 2);
+        for (i = 1; i < array_count(blocks); i += 2)
+            cat_free(blocks[i]);
+        result = result && (cat_malloc_report(false) == live);
+        printf("\nMalloc tracking: %s", result ? "Success" : "Failed");
+    }
+#endif // #ifdef CAT_DEBUG
+
     bool pool = cat_memory_pool_create(1024);
     if (!pool)
     {
@@ -280,6 +3304,7 @@ cat_noinl void cat_memory_test(void)
     cat_memset(testA, 1, 128);
     cat_memset(testB, 2, 512);
     printf("\nWrote to block A & B");
+    cat_memory_test_stats("after A & B");
 
     void* testC = cat_memory_alloc(400);
     printf("\nTry allocate block C of size 400: %s", testC != NULL ? "Success" : "Failed");
@@ -293,12 +3318,530 @@ cat_noinl void cat_memory_test(void)
     result = cat_memory_dealloc(testB);
     printf("\nDeallocated block B: %s", result ? "Success" : "Failed");
 
-    result = cat_memory_dealloc(testC);
+    // A and B coalesce with free tail, so C now fits
+    testC = cat_memory_alloc(400);
+    printf("\nTry allocate block C of size 400: %s", testC != NULL ? "Success" : "Failed");
+
+    result = testC && cat_memory_dealloc(testC);
     printf("\nDeallocated block C: %s", result ? "Success" : "Failed");
+    printf("\nPool is consistent: %s", cat_memory_internal_pool_validate(&memoryDefault) ? "Success" : "Failed");
+    cat_memory_test_stats("after all freed");
 
     cat_memory_pool_destroy();
     printf("\n\nPool destroyed");
+
+    // churn: random sizes for many iterations in a fixed pool, both policies
+    {
+        cat_memory_pool_t pool_churn;
+        void* blocks[64] = { NULL };
+        uint32_t seed = 1, iter = 0, i = 0, fail = 0;
+        cat_memory_policy_t const policies[] = { cat_memory_policy_first_fit, cat_memory_policy_best_fit };
+        cat_memory_policy_t policy = cat_memory_policy_first_fit;
+        uint32_t p = 0;
+        for (p = 0; p < array_count(policies); ++p)
+        {
+            policy = policies[p];
+            result = cat_memory_pool_init(&pool_churn, 65536) && cat_memory_pool_set_policy(&pool_churn, policy);
+            for (iter = 0, fail = 0; result && iter < 100000; ++iter)
+            {
+                seed = seed * 1664525 + 1013904223;
+                i = (seed >> 8) % array_count(blocks);
+                if (blocks[i])
+                {
+                    result = cat_memory_pool_dealloc(&pool_churn, blocks[i]);
+                    blocks[i] = NULL;
+                }
+                else
+                {
+                    blocks[i] = cat_memory_pool_alloc(&pool_churn, 1 + (seed >> 16) % 2048);
+                    fail += (blocks[i] == NULL);
+                }
+            }
+            for (i = 0; i < array_count(blocks); ++i)
+            {
+                if (blocks[i])
+                    cat_memory_pool_dealloc(&pool_churn, blocks[i]);
+                blocks[i] = NULL;
+            }
+            result = result && cat_memory_internal_pool_validate(&pool_churn) && (pool_churn.p_free_head == (cat_memory_free_block_t*)pool_churn.p_begin) && !cat_memory_internal_slab_used(&pool_churn);
+            printf("\nPool churn (%s): %s (%"PRIu32" failed requests)", policy == cat_memory_policy_first_fit ? "first-fit" : "best-fit", result ? "Success" : "Failed", fail);
+            cat_memory_pool_term(&pool_churn);
+        }
+    }
+
+    // same general block workload on both backends: buddy trades internal fragmentation for bounded search
+    {
+        cat_memory_pool_t pool_backend;
+        void* blocks[64] = { NULL };
+        uint32_t seed = 7, iter = 0, i = 0, fail = 0, b = 0;
+        double internal = 0.0, external = 0.0;
+        cat_time_t t = 0;
+        cat_memory_backend_t const backends[] = { cat_memory_backend_free_list, cat_memory_backend_buddy };
+        for (b = 0; b < array_count(backends); ++b)
+        {
+            cat_memory_pool_desc_t const desc = { 4 * 1024 * 1024, cat_memory_policy_first_fit, 0, backends[b] };
+            result = cat_memory_pool_init_desc(&pool_backend, &desc);
+            t = cat_platform_time();
+            for (iter = 0, fail = 0; result && iter < 100000; ++iter)
+            {
+                seed = seed * 1664525 + 1013904223;
+                i = (seed >> 8) % array_count(blocks);
+                if (blocks[i])
+                {
+                    result = cat_memory_pool_dealloc(&pool_backend, blocks[i]);
+                    blocks[i] = NULL;
+                }
+                else
+                {
+                    blocks[i] = cat_memory_pool_alloc(&pool_backend, 2049 + (seed >> 12) % 30000);
+                    fail += (blocks[i] == NULL);
+                }
+            }
+            t = cat_platform_time() - t;
+            result = result && cat_memory_pool_fragmentation(&pool_backend, &internal, &external) && cat_memory_internal_pool_validate(&pool_backend);
+            for (i = 0; i < array_count(blocks); ++i)
+            {
+                if (blocks[i])
+                    cat_memory_pool_dealloc(&pool_backend, blocks[i]);
+                blocks[i] = NULL;
+            }
+            result = result && !pool_backend.block_count && !pool_backend.used && cat_memory_internal_pool_validate(&pool_backend);
+            printf("\nPool backend (%s): %s (%"PRIu32" failed requests, %.1f%% internal, %.1f%% external fragmentation, %"PRIi64" ticks)",
+                backends[b] == cat_memory_backend_buddy ? "buddy" : "free list", result ? "Success" : "Failed", fail, internal * 100.0, external * 100.0, t);
+            cat_memory_pool_term(&pool_backend);
+        }
+    }
+
+    // small fixed-size records come from slabs in constant time
+    {
+        cat_memory_pool_t pool_slab;
+        void* blocks[1024] = { NULL };
+        uint32_t i = 0, in_slab = 0;
+        cat_time_t t = 0;
+        result = cat_memory_pool_init(&pool_slab, 1024 * 1024);
+        t = cat_platform_time();
+        for (i = 0; result && i < array_count(blocks); ++i)
+        {
+            blocks[i] = cat_memory_pool_alloc(&pool_slab, 24 + (i % 3) * 40);
+            in_slab += ((uint8_t*)blocks[i] >= pool_slab.p_slab_begin && (uint8_t*)blocks[i] < pool_slab.p_slab_end);
+        }
+        for (i = 0; result && i < array_count(blocks); ++i)
+            result = cat_memory_pool_dealloc(&pool_slab, blocks[(i * 7) % array_count(blocks)]);
+        t = cat_platform_time() - t;
+        result = result && (in_slab == array_count(blocks)) && !cat_memory_internal_slab_used(&pool_slab) && !pool_slab.block_count && cat_memory_internal_pool_validate(&pool_slab);
+        printf("\nPool slabs: %s (%"PRIu32" of %"PRIu32" in slabs, %"PRIi64" ticks)", result ? "Success" : "Failed", in_slab, (uint32_t)array_count(blocks), t);
+        cat_memory_pool_term(&pool_slab);
+    }
+
+    // growing array: resizes stay in place while successor is free, contents survive moves and shrinks
+    {
+        cat_memory_pool_t pool_grow;
+        cat_memory_pool_stats_t stats;
+        cat_memory_backend_t const backends[] = { cat_memory_backend_free_list, cat_memory_backend_buddy };
+        uint8_t* p_array = NULL, * p_resized = NULL;
+        void* p_blocker = NULL;
+        size_t size = 0, i = 0;
+        uint32_t b = 0, steps = 0, moves = 0;
+        for (b = 0; b < array_count(backends); ++b)
+        {
+            cat_memory_pool_desc_t const desc = { 4 * 1024 * 1024, cat_memory_policy_first_fit, 0, backends[b] };
+            result = cat_memory_pool_init_desc(&pool_grow, &desc);
+            p_array = (result ? (uint8_t*)cat_memory_pool_alloc(&pool_grow, 3000) : NULL);
+            result = (p_array != NULL);
+            for (i = 0; result && i < 3000; ++i)
+                p_array[i] = (uint8_t)i;
+            for (size = 3000, steps = moves = 0; result && size < 1024 * 1024; ++steps)
+            {
+                // blocker after array half way forces one move
+                if (steps == 8)
+                    p_blocker = cat_memory_pool_alloc(&pool_grow, 3000);
+                p_resized = (uint8_t*)cat_memory_pool_realloc(&pool_grow, p_array, size + size / 4);
+                result = (p_resized != NULL);
+                moves += (p_resized != p_array);
+                p_array = (result ? p_resized : p_array);
+                for (i = size; result && i < size + size / 4; ++i)
+                    p_array[i] = (uint8_t)i;
+                size += size / 4;
+            }
+            p_resized = (result ? (uint8_t*)cat_memory_pool_realloc(&pool_grow, p_array, 3000) : NULL);
+            result = (p_resized == p_array) && cat_memory_internal_pool_validate(&pool_grow);
+            for (i = 0; result && i < 3000; ++i)
+                result = (p_array[i] == (uint8_t)i);
+            result = result && cat_memory_pool_dealloc(&pool_grow, p_array) && (!p_blocker || cat_memory_pool_dealloc(&pool_grow, p_blocker));
+            result = result && !pool_grow.used && cat_memory_internal_pool_validate(&pool_grow) && cat_memory_pool_stats(&pool_grow, &stats) && !stats.live_blocks;
+            for (i = 0; result && i < CAT_MEMORY_HISTOGRAM_BINS; ++i)
+                result = !stats.histogram[i];
+            printf("\nPool realloc (%s): %s (%"PRIu32" of %"PRIu32" growth steps moved)",
+                backends[b] == cat_memory_backend_buddy ? "buddy" : "free list", result ? "Success" : "Failed", moves, steps);
+            cat_memory_pool_term(&pool_grow);
+            p_blocker = NULL;
+        }
+    }
+
+    // fixture built once is restored before every run instead of rebuilt; mapped pool restores copy-on-write, node local pool copies to keep binding
+    {
+        cat_memory_pool_t pool_fixture;
+        cat_memory_pool_snapshot_t snapshot = { NULL, { NULL }, NULL, 0, 0, -1 };
+        cat_memory_pool_stats_t stats_built, stats_restored;
+        cat_memory_pool_desc_t desc = { 16 * 1024 * 1024, cat_memory_policy_first_fit, 0, cat_memory_backend_free_list };
+        uint32_t const flags[] = { 0, cat_memory_pool_flag_mapped, cat_memory_pool_flag_node_local };
+        char const* const names[] = { "heap", "mapped", "node local" };
+        uint8_t* blocks[2048] = { NULL };
+        void* p_first = NULL, * p_next = NULL;
+        uint64_t hash_built = 0, hash_restored = 0;
+        uint32_t seed = 0, i = 0, run = 0, f = 0;
+        cat_time_t t_build = 0, t_restore = 0;
+        for (f = 0, result = true; result && f < array_count(flags); ++f)
+        {
+            desc.flags = flags[f];
+            result = cat_memory_pool_init_desc(&pool_fixture, &desc);
+            t_build = cat_platform_time();
+            for (i = 0, seed = 3; result && i < array_count(blocks); ++i)
+            {
+                seed = seed * 1664525 + 1013904223;
+                blocks[i] = (uint8_t*)cat_memory_pool_alloc(&pool_fixture, 16 + (seed >> 12) % 6000);
+                result = (blocks[i] != NULL);
+                if (result)
+                    cat_memset(blocks[i], (uint8_t)i, 16);
+            }
+            t_build = cat_platform_time() - t_build;
+            for (i = 0, hash_built = 0; result && i < array_count(blocks); ++i)
+                hash_built ^= cat_memory_hash(blocks[i], 16, i);
+            result = result && cat_memory_pool_stats(&pool_fixture, &stats_built) && cat_memory_pool_snapshot(&pool_fixture, &snapshot);
+            result = result && !((flags[f] & cat_memory_pool_flag_node_local) && snapshot.image_file >= 0);
+            for (run = 0, t_restore = 0; result && run < 4; ++run)
+            {
+                // run frees, allocates and scribbles over fixture; next allocation after restore lands where it did after build
+                p_next = cat_memory_pool_alloc(&pool_fixture, 5000);
+                p_first = (run ? p_first : p_next);
+                result = (p_next == p_first);
+                for (i = 0; result && i < array_count(blocks); i += 2)
+                {
+                    cat_memset(blocks[i + 1], 0xCD, 16);
+                    result = cat_memory_pool_dealloc(&pool_fixture, blocks[i]) && cat_memory_pool_alloc(&pool_fixture, 100);
+                }
+                t_restore -= cat_platform_time();
+                result = result && cat_memory_pool_restore(&pool_fixture, &snapshot);
+                t_restore += cat_platform_time();
+                for (i = 0, hash_restored = 0; result && i < array_count(blocks); ++i)
+                    hash_restored ^= cat_memory_hash(blocks[i], 16, i);
+                result = result && (hash_restored == hash_built) && cat_memory_internal_pool_validate(&pool_fixture) &&
+                    cat_memory_pool_stats(&pool_fixture, &stats_restored) && !memcmp(&stats_built, &stats_restored, sizeof(stats_built));
+            }
+            printf("\nPool snapshot (%s, %s): %s (build %"PRIi64" ticks, restore %"PRIi64" ticks)",
+                names[f], snapshot.image_file >= 0 ? "copy-on-write" : "copy", result ? "Success" : "Failed", t_build, t_restore / 4);
+            cat_memory_pool_snapshot_release(&snapshot);
+            cat_memory_pool_term(&pool_fixture);
+        }
+    }
+
+    {
+        cat_memory_pool_t pool_a, pool_b;
+        void* p_a = NULL, * p_b = NULL, * p_c = NULL;
+        result = cat_memory_pool_create(4096) && cat_memory_pool_init(&pool_a, 4096) && cat_memory_pool_init(&pool_b, 4096);
+        p_a = cat_memory_pool_alloc(&pool_a, 3000);
+        p_b = cat_memory_pool_alloc(&pool_b, 3000);
+        p_c = cat_memory_alloc(3000);
+        result = result && p_a && p_b && p_c && !cat_memory_pool_alloc(&pool_a, 3000) &&
+            cat_memory_pool_dealloc(&pool_a, p_a) && cat_memory_pool_dealloc(&pool_b, p_b) && cat_memory_dealloc(p_c);
+        printf("\nPool instances: %s", result ? "Success" : "Failed");
+        cat_memory_pool_term(&pool_b);
+        cat_memory_pool_term(&pool_a);
+        cat_memory_pool_destroy();
+    }
+
+    // aligned blocks: small ones from slabs, large ones from general blocks with gaps reused
+    {
+        cat_memory_pool_t pool_align;
+        size_t const aligns[] = { 32, 64, 256, 4096 };
+        void* blocks[64] = { NULL };
+        uint8_t* p_aligned = NULL;
+        size_t align = 0, requested = 0;
+        uint32_t i = 0, misaligned = 0;
+        result = cat_memory_pool_init(&pool_align, 1024 * 1024);
+        for (i = 0; result && i < array_count(blocks); ++i)
+        {
+            align = aligns[i % array_count(aligns)];
+            blocks[i] = cat_memory_pool_alloc_aligned(&pool_align, 24 + i * 97, align);
+            misaligned += (!blocks[i] || ((size_t)blocks[i] & (align - 1)));
+            if (blocks[i])
+                cat_memset(blocks[i], 0xA5, 24 + i * 97);
+            if ((uint8_t*)blocks[i] >= (uint8_t*)pool_align.p_begin && (uint8_t*)blocks[i] < (uint8_t*)pool_align.p_end)
+                requested += 24 + i * 97;
+        }
+        printf("\nPool aligned: %"PRIu32" general blocks, %.1f%% of general bytes are headers and padding", pool_align.block_count,
+            100.0 * (1.0 - (double)requested / (double)pool_align.used));
+
+        // growing past neighbours moves block, which keeps its alignment and contents
+        for (i = 3; result && i < array_count(blocks); i += 4)
+        {
+            p_aligned = (uint8_t*)cat_memory_pool_realloc_aligned(&pool_align, blocks[i], 24 + i * 97 + 8192, aligns[i % array_count(aligns)]);
+            result = (p_aligned != NULL) && !((size_t)p_aligned & (aligns[i % array_count(aligns)] - 1)) && (p_aligned[23 + i * 97] == 0xA5);
+            blocks[i] = (p_aligned ? p_aligned : blocks[i]);
+        }
+        for (i = 0; result && i < array_count(blocks); i += 2)
+            result = cat_memory_pool_dealloc(&pool_align, blocks[i]);
+        for (i = 1; result && i < array_count(blocks); i += 2)
+            result = cat_memory_pool_dealloc(&pool_align, blocks[i]);
+        result = result && !misaligned && !pool_align.block_count && cat_memory_internal_pool_validate(&pool_align);
+        printf("\nPool aligned: %s", result ? "Success" : "Failed");
+        cat_memory_pool_term(&pool_align);
+
+        p_aligned = (uint8_t*)cat_malloc_aligned(1000, 64);
+        result = p_aligned && !((size_t)p_aligned & 63);
+        printf("\nMalloc aligned: %s", result ? "Success" : "Failed");
+        if (p_aligned)
+            cat_free_aligned(p_aligned);
+    }
+
+    // arena: temporaries released together by rewind, scratch released by test driver
+    {
+        cat_memory_pool_t pool_arena;
+        cat_memory_arena_t arena;
+        cat_memory_arena_t* const p_scratch = cat_memory_scratch();
+        cat_memory_arena_mark_t mark = 0;
+        uint32_t i = 0, iter = 0;
+        void* p_temp = NULL;
+        result = cat_memory_pool_init(&pool_arena, 1024 * 1024) && cat_memory_arena_init(&arena, &pool_arena, 256 * 1024);
+        for (iter = 0; result && iter < 1000; ++iter)
+        {
+            mark = cat_memory_arena_mark(&arena);
+            for (i = 0; result && i < 64; ++i)
+                result = ((p_temp = cat_memory_arena_alloc(&arena, 1 + (i * 37) % 1024, 16)) != NULL) && !((size_t)p_temp & 15);
+            result = result && cat_memory_arena_rewind(&arena, mark) && (arena.offset == mark);
+        }
+        result = result && cat_memory_arena_reset(&arena) && !cat_memory_arena_alloc(&arena, 256 * 1024 + 1, 1) &&
+            cat_memory_arena_term(&arena) && !pool_arena.block_count;
+        if (p_scratch)
+            result = result && cat_memory_arena_alloc(p_scratch, 4096, 64);
+        printf("\nPool arena: %s", result ? "Success" : "Failed");
+        cat_memory_pool_term(&pool_arena);
+    }
+
+    // guard pages: at rate one every block is sampled until slots run out; block ends at guard page and fault report classifies access
+    {
+        char report[512];
+        uint8_t* blocks[9] = { NULL };
+        uint8_t* p_page = NULL, * p_moved = NULL;
+        void* p_block = NULL;
+        uint32_t i = 0, guarded = 0;
+        result = cat_memory_guard_enable(1, 8);
+        for (i = 0; result && i < array_count(blocks); ++i)
+        {
+            blocks[i] = (uint8_t*)cat_malloc(100 + i);
+            result = (blocks[i] != NULL);
+            if (result)
+                cat_memset(blocks[i], (uint8_t)i, 100 + i);
+            guarded += (result && cat_memory_guard_owns(blocks[i]));
+        }
+        for (i = 0; result && i < 8; ++i)
+        {
+            p_page = (uint8_t*)((size_t)blocks[i] & ~(CAT_MEMORY_PAGE_SIZE - 1));
+            result = (blocks[i] + 100 + i == p_page + CAT_MEMORY_PAGE_SIZE) &&
+                cat_memory_internal_guard_describe(report, sizeof(report), p_page + CAT_MEMORY_PAGE_SIZE) && strstr(report, "overflow") &&
+                cat_memory_internal_guard_describe(report, sizeof(report), p_page - 1) && strstr(report, "underflow");
+        }
+        if (result)
+            printf("%s", report);
+        cat_free(blocks[0]);
+        result = result && (guarded == 8) && !cat_memory_guard_owns(blocks[8]) &&
+            cat_memory_internal_guard_describe(report, sizeof(report), blocks[0]) && strstr(report, "use after release");
+        p_moved = (result ? (uint8_t*)cat_realloc(blocks[1], 5000) : NULL);
+        result = (p_moved != NULL) && !cat_memory_guard_owns(p_moved) && (p_moved[100] == 1);
+        blocks[1] = (p_moved ? p_moved : blocks[1]);
+        for (i = 1; i < array_count(blocks); ++i)
+            cat_free(blocks[i]);
+        result = result && cat_memory_guard_disable() && !cat_memory_guard_owns(blocks[2]);
+
+        // default pool blocks are sampled too and move into pool when resized
+        result = result && cat_memory_pool_create(1024 * 1024) && cat_memory_guard_enable(1, 0);
+        p_block = (result ? cat_memory_alloc(64) : NULL);
+        result = (p_block != NULL) && cat_memory_guard_owns(p_block);
+        p_moved = (result ? (uint8_t*)cat_memory_realloc(cat_memset(p_block, 0x5A, 64), 200) : NULL);
+        result = (p_moved != NULL) && !cat_memory_guard_owns(p_moved) && (p_moved[63] == 0x5A) && cat_memory_dealloc(p_moved) && cat_memory_guard_disable();
+        cat_memory_pool_destroy();
+        printf("\nMalloc guard: %s", result ? "Success" : "Failed");
+    }
+
+    // concurrent pool: threads share pool while small blocks go through per-thread caches
+    {
+        cat_memory_pool_desc_t const desc = { 16 * 1024 * 1024, cat_memory_policy_first_fit, cat_memory_pool_flag_concurrent, cat_memory_backend_free_list };
+        cat_memory_pool_t pool_mt;
+        result = cat_memory_pool_init_desc(&pool_mt, &desc);
+        result = result && cat_memory_test_concurrent(&pool_mt, 4, 100000, NULL);
+        printf("\nPool concurrent: %s", result ? "Success" : "Failed");
+        cat_memory_pool_term(&pool_mt);
+    }
+
+    // backing memory: every backing can be created, allocated from, written across and released
+    {
+        cat_memory_pool_t pool_map;
+        cat_memory_pool_desc_t desc = { 4 * 1024 * 1024, cat_memory_policy_first_fit, 0, cat_memory_backend_free_list };
+        uint32_t const flags[] = { 0, cat_memory_pool_flag_mapped, cat_memory_pool_flag_mapped | cat_memory_pool_flag_prefault, cat_memory_pool_flag_huge_pages, cat_memory_pool_flag_huge_tlb, cat_memory_pool_flag_node_local };
+        size_t const block_size = 1024 * 1024;
+        uint8_t* p_block = NULL;
+        size_t offset = 0;
+        uint32_t f = 0;
+        for (f = 0, result = true; result && f < array_count(flags); ++f)
+        {
+            desc.flags = flags[f];
+            if (!cat_memory_pool_init_desc(&pool_map, &desc))
+            {
+                result = false;
+                break;
+            }
+            p_block = (uint8_t*)cat_memory_pool_alloc(&pool_map, block_size);
+            result = (p_block != NULL);
+            for (offset = 0; result && offset < block_size; offset += 4096)
+                p_block[offset] = (uint8_t)(offset >> 12);
+            result = result && (p_block[block_size - 4096] == (uint8_t)((block_size - 4096) >> 12)) && cat_memory_pool_dealloc(&pool_map, p_block);
+            result = cat_memory_pool_term(&pool_map) && result;
+        }
+        printf("\nPool backing: %s", result ? "Success" : "Failed");
+    }
 }
 
 
+cat_noinl void cat_memory_bench(void)
+{
+    // bytes per second for each kernel against standard library, from cache-resident to memory-bound sizes
+    static char const* const names[] = { "libc/scalar", "SSE2", "AVX2", "AVX-512" };
+    static char const* const ops[] = { "memset", "memcpy", "memcmp", "hash" };
+    size_t const size_max = (size_t)256 * 1024 * 1024, work = (size_t)256 * 1024 * 1024;
+    uint8_t* const p_src = (uint8_t*)cat_malloc(size_max);
+    uint8_t* const p_dst = (uint8_t*)cat_malloc(size_max);
+    cat_memory_simd_t const simd = cat_memory_simd();
+    cat_memory_simd_t level = cat_memory_simd_none;
+    size_t size = 0, rep = 0, reps = 0;
+    uint32_t op = 0;
+    bool volatile sink = false;
+    uint64_t volatile digest = 0;
+    double const rate = (double)cat_platform_time_rate();
+    cat_time_t t = 0;
+    if (p_src && p_dst)
+    {
+        memset(p_src, 0x5A, size_max);
+        memset(p_dst, 0x5A, size_max);
+        for (op = 0; op < array_count(ops); ++op)
+        {
+            for (size = 8; size <= size_max; size = (size * 8 > size_max && size < size_max ? size_max : size * 8))
+            {
+                reps = (work / size ? work / size : 1);
+                printf("\nMemory bench %s %12zu B:", ops[op], size);
+                for (level = cat_memory_simd_none; level <= cat_memory_simd_supported(); ++level)
+                {
+                    cat_memory_set_simd(level);
+                    t = cat_platform_time();
+                    for (rep = 0; rep < reps; ++rep)
+                    {
+                        if (op == 0)
+                            cat_memset(p_dst, (uint8_t)rep, size);
+                        else if (op == 1)
+                            cat_memcpy(p_dst, p_src, size);
+                        else if (op == 2)
+                            sink = cat_memcmp(p_dst, p_src, size);
+                        else
+                            digest = cat_memory_hash(p_src, size, rep);
+                    }
+                    t = cat_platform_time() - t;
+                    printf(" %s %6.2f", names[level], (double)size * reps * rate / (double)(t ? t : 1) * 1e-9);
+                }
+                printf(" GB/s");
+            }
+        }
+        cat_memory_set_simd(simd);
+    }
+    unused2(sink, digest);
+    if (p_dst)
+        cat_free(p_dst);
+    if (p_src)
+        cat_free(p_src);
+
+    // backing memory: first touch pays page faults unless prefaulted, huge pages cut faults and TLB misses on random access,
+    // node local keeps pages on creating thread's node whoever touches them
+    {
+        cat_memory_pool_t pool_map;
+        cat_memory_pool_desc_t desc = { 256 * 1024 * 1024, cat_memory_policy_first_fit, 0, cat_memory_backend_free_list };
+        uint32_t const flags[] = { 0, cat_memory_pool_flag_mapped, cat_memory_pool_flag_mapped | cat_memory_pool_flag_prefault, cat_memory_pool_flag_huge_pages, cat_memory_pool_flag_huge_tlb, cat_memory_pool_flag_node_local };
+        char const* const backing_names[] = { "heap", "mapped", "mapped prefault", "huge pages", "huge tlb", "node local" };
+        size_t const block_size = 128 * 1024 * 1024;
+        uint64_t volatile touch_sink = 0;
+        uint64_t sum = 0;
+        uint8_t* p_block = NULL;
+        size_t i = 0, offset = 0;
+        uint32_t seed = 1, f = 0;
+        cat_time_t t_init = 0, t_touch = 0, t_random = 0;
+        double const ms = 1000.0 / (double)cat_platform_time_rate();
+        bool result = true;
+        for (f = 0; result && f < array_count(flags); ++f)
+        {
+            desc.flags = flags[f];
+            t_init = cat_platform_time();
+            result = cat_memory_pool_init_desc(&pool_map, &desc);
+            t_init = cat_platform_time() - t_init;
+            p_block = (result ? (uint8_t*)cat_memory_pool_alloc(&pool_map, block_size) : NULL);
+            result = (p_block != NULL);
+            if (!result)
+                break;
+            t_touch = cat_platform_time();
+            for (offset = 0; offset < block_size; offset += 4096)
+                p_block[offset] = (uint8_t)offset;
+            t_touch = cat_platform_time() - t_touch;
+            t_random = cat_platform_time();
+            for (i = 0, sum = 0; i < 4 * 1024 * 1024; ++i)
+            {
+                seed = seed * 1664525 + 1013904223;
+                sum += p_block[((size_t)seed * 4099) % block_size];
+            }
+            t_random = cat_platform_time() - t_random;
+            touch_sink = sum;
+            printf("\nPool backing bench (%s): init %.2f ms, first touch %.2f ms, %.1f ns per random access",
+                backing_names[f], (double)t_init * ms, (double)t_touch * ms, (double)t_random * ms * 1e6 / (4.0 * 1024 * 1024));
+            result = cat_memory_pool_dealloc(&pool_map, p_block) && cat_memory_pool_term(&pool_map);
+        }
+        unused(touch_sink);
+    }
+
+    // concurrent pool: throughput should scale with threads since small blocks rarely touch shared state
+    {
+        cat_memory_pool_desc_t const desc = { 16 * 1024 * 1024, cat_memory_policy_first_fit, cat_memory_pool_flag_concurrent, cat_memory_backend_free_list };
+        cat_memory_pool_t pool_mt;
+        uint32_t const count = 1000000;
+        uint32_t thread_count = 0;
+        cat_time_t t_mt = 0;
+        bool const created = cat_memory_pool_init_desc(&pool_mt, &desc);
+        bool result = created;
+        for (thread_count = 1; result && thread_count <= 8; thread_count *= 2)
+        {
+            result = cat_memory_test_concurrent(&pool_mt, thread_count, count, &t_mt);
+            printf("\nPool concurrent bench: %"PRIu32" threads, %.1f M alloc/free per second", thread_count,
+                (double)count * thread_count * cat_platform_time_rate() / (double)(t_mt ? t_mt : 1) * 1e-6);
+        }
+        if (created)
+            cat_memory_pool_term(&pool_mt);
+    }
+
+    // guard pages at default rate: cost of sampling check on every call and occasional page protection change, after warm-up pass
+    {
+        uint32_t const count = 1000000;
+        uint32_t i = 0;
+        cat_time_t t_off = 0, t_on = 0;
+        bool result = false;
+        for (i = 0; i < count; ++i)
+            cat_free(cat_malloc(64));
+        for (i = 0, t_off = cat_platform_time(); i < count; ++i)
+            cat_free(cat_malloc(64));
+        t_off = cat_platform_time() - t_off;
+        result = cat_memory_guard_enable(0, 0);
+        for (i = 0, t_on = cat_platform_time(); result && i < count; ++i)
+            cat_free(cat_malloc(64));
+        t_on = cat_platform_time() - t_on;
+        if (result)
+        {
+            printf("\nMalloc guard bench: %"PRIu32" of %"PRIu32" sampled, %.2f%% overhead", cat_memory_guard_sampled(), count, 100.0 * ((double)t_on / (double)(t_off ? t_off : 1) - 1.0));
+            cat_memory_guard_disable();
+        }
+    }
+}
+
 cat_implementation_end;
\ No newline at end of file
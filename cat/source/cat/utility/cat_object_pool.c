@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+* cat_object_pool.c
+* Generational object pool implementation.
+*/
+
+#include "cat/utility/cat_object_pool.h"
+#include "cat/cat_platform.inl"
+
+#include <string.h>
+
+
+cat_implementation_begin;
+
+
+#define CAT_OBJECT_INDEX_MASK       (CAT_OBJECT_CAPACITY_MAX - 1)
+#define CAT_OBJECT_GENERATION_LIMIT ((uint32_t)1 << (32 - CAT_OBJECT_INDEX_BITS))
+
+
+static void* cat_object_pool_internal_alloc(cat_memory_pool_t* const p_pool, size_t const block_size)
+{
+    return (p_pool ? cat_memory_pool_alloc(p_pool, block_size) : cat_malloc(block_size));
+}
+
+static void cat_object_pool_internal_free(cat_memory_pool_t* const p_pool, void* const p_block)
+{
+    if (!p_block)
+        return;
+    if (p_pool)
+        cat_memory_pool_dealloc(p_pool, p_block);
+    else
+        cat_free(p_block);
+}
+
+static cat_object_slot_t* cat_object_pool_internal_slot(cat_object_pool_t const* const p_objects, cat_object_handle_t const handle)
+{
+    // live slot only if index is in use and generation matches
+    uint32_t const index = (handle & CAT_OBJECT_INDEX_MASK), generation = (handle >> CAT_OBJECT_INDEX_BITS);
+    cat_object_slot_t* const p_slot = p_objects->p_slot + index;
+    if (index >= p_objects->slot_bump || p_slot->generation != generation || p_slot->dense >= p_objects->count || p_objects->p_owner[p_slot->dense] != index)
+        return NULL;
+    return p_slot;
+}
+
+
+cat_impl bool cat_object_pool_init(cat_object_pool_t* const p_objects, cat_memory_pool_t* const p_pool, size_t const object_size, uint32_t const capacity)
+{
+    assert_or_bail(p_objects) false;
+    assert_or_bail(object_size) false;
+    assert_or_bail(capacity && capacity <= CAT_OBJECT_CAPACITY_MAX) false;
+    memset(p_objects, 0, sizeof(*p_objects));
+    p_objects->p_pool = p_pool;
+    p_objects->object_size = object_size;
+    p_objects->capacity = capacity;
+    p_objects->free_head = capacity;
+    p_objects->p_data = (uint8_t*)cat_object_pool_internal_alloc(p_pool, object_size * capacity);
+    p_objects->p_slot = (cat_object_slot_t*)cat_object_pool_internal_alloc(p_pool, sizeof(cat_object_slot_t) * capacity);
+    p_objects->p_owner = (uint32_t*)cat_object_pool_internal_alloc(p_pool, sizeof(uint32_t) * capacity);
+    if (!p_objects->p_data || !p_objects->p_slot || !p_objects->p_owner)
+    {
+        cat_object_pool_term(p_objects);
+        return false;
+    }
+    return true;
+}
+
+cat_impl bool cat_object_pool_term(cat_object_pool_t* const p_objects)
+{
+    assert_or_bail(p_objects) false;
+    cat_object_pool_internal_free(p_objects->p_pool, p_objects->p_owner);
+    cat_object_pool_internal_free(p_objects->p_pool, p_objects->p_slot);
+    cat_object_pool_internal_free(p_objects->p_pool, p_objects->p_data);
+    memset(p_objects, 0, sizeof(*p_objects));
+    return true;
+}
+
+cat_impl void* cat_object_pool_create(cat_object_pool_t* const p_objects, cat_object_handle_t* const p_handle_out)
+{
+    cat_object_slot_t* p_slot = NULL;
+    uint32_t index = 0;
+    void* p_object = NULL;
+    assert_or_bail(p_objects && p_objects->p_data) NULL;
+    assert_or_bail(p_handle_out) NULL;
+    *p_handle_out = CAT_OBJECT_HANDLE_NULL;
+    if (p_objects->count == p_objects->capacity)
+        return NULL;
+
+    // reuse freed slot, otherwise take next untouched slot starting at generation 1 so null handle is never live
+    if (p_objects->free_head < p_objects->capacity)
+    {
+        index = p_objects->free_head;
+        p_slot = p_objects->p_slot + index;
+        p_objects->free_head = p_slot->dense;
+    }
+    else
+    {
+        index = p_objects->slot_bump++;
+        p_slot = p_objects->p_slot + index;
+        p_slot->generation = 1;
+    }
+
+    // record goes at end of dense array
+    p_slot->dense = p_objects->count++;
+    p_objects->p_owner[p_slot->dense] = index;
+    p_object = p_objects->p_data + (size_t)p_slot->dense * p_objects->object_size;
+    memset(p_object, 0, p_objects->object_size);
+    *p_handle_out = (p_slot->generation << CAT_OBJECT_INDEX_BITS) | index;
+    return p_object;
+}
+
+cat_impl bool cat_object_pool_destroy(cat_object_pool_t* const p_objects, cat_object_handle_t const handle)
+{
+    cat_object_slot_t* p_slot = NULL;
+    uint32_t dense = 0, last = 0;
+    assert_or_bail(p_objects && p_objects->p_data) false;
+    p_slot = cat_object_pool_internal_slot(p_objects, handle);
+    if (!p_slot)
+        return false;
+
+    // move last record into hole to keep records dense
+    dense = p_slot->dense;
+    last = --p_objects->count;
+    if (dense != last)
+    {
+        memcpy(p_objects->p_data + (size_t)dense * p_objects->object_size, p_objects->p_data + (size_t)last * p_objects->object_size, p_objects->object_size);
+        p_objects->p_owner[dense] = p_objects->p_owner[last];
+        p_objects->p_slot[p_objects->p_owner[dense]].dense = dense;
+    }
+
+    // new generation makes outstanding handles stale; generation wraps past zero
+    p_slot->generation = (p_slot->generation + 1) % CAT_OBJECT_GENERATION_LIMIT;
+    if (!p_slot->generation)
+        p_slot->generation = 1;
+    p_slot->dense = p_objects->free_head;
+    p_objects->free_head = (uint32_t)(p_slot - p_objects->p_slot);
+    return true;
+}
+
+cat_impl void* cat_object_pool_get(cat_object_pool_t const* const p_objects, cat_object_handle_t const handle)
+{
+    cat_object_slot_t const* p_slot = NULL;
+    assert_or_bail(p_objects && p_objects->p_data) NULL;
+    p_slot = cat_object_pool_internal_slot(p_objects, handle);
+    return (p_slot ? p_objects->p_data + (size_t)p_slot->dense * p_objects->object_size : NULL);
+}
+
+cat_impl void* cat_object_pool_at(cat_object_pool_t const* const p_objects, uint32_t const dense, cat_object_handle_t* const p_handle_out)
+{
+    uint32_t index = 0;
+    assert_or_bail(p_objects && p_objects->p_data) NULL;
+    assert_or_bail(dense < p_objects->count) NULL;
+    index = p_objects->p_owner[dense];
+    if (p_handle_out)
+        *p_handle_out = (p_objects->p_slot[index].generation << CAT_OBJECT_INDEX_BITS) | index;
+    return p_objects->p_data + (size_t)dense * p_objects->object_size;
+}
+
+
+#include "cat/utility/cat_time.h"
+#include "cat/utility/cat_console.h"
+
+
+//! \struct cat_object_pool_test_record_s
+//! \brief Test record.
+typedef struct cat_object_pool_test_record_s
+{
+    uint32_t id;     //< Creation number.
+    float    pos[3]; //< Payload.
+} cat_object_pool_test_record_t;
+
+
+cat_noinl void cat_object_pool_test(void)
+{
+    cat_memory_pool_t pool;
+    cat_object_pool_t objects;
+    cat_object_handle_t handles[4096] = { CAT_OBJECT_HANDLE_NULL }, handle = CAT_OBJECT_HANDLE_NULL;
+    cat_object_pool_test_record_t* p_record = NULL;
+    uint32_t i = 0, stale = 0, sum = 0, expect = 0;
+    cat_time_t t = 0;
+    bool result = cat_memory_pool_init(&pool, 1024 * 1024) && cat_object_pool_init(&objects, &pool, sizeof(cat_object_pool_test_record_t), array_count(handles));
+
+    // fill, then destroy every third record; handles to destroyed records go stale, others still resolve
+    for (i = 0; result && i < array_count(handles); ++i)
+    {
+        p_record = (cat_object_pool_test_record_t*)cat_object_pool_create(&objects, &handles[i]);
+        result = (p_record != NULL) && (handles[i] != CAT_OBJECT_HANDLE_NULL);
+        if (result)
+            p_record->id = i;
+    }
+    result = result && !cat_object_pool_create(&objects, &handle) && (handle == CAT_OBJECT_HANDLE_NULL);
+    for (i = 0; result && i < array_count(handles); i += 3)
+        result = cat_object_pool_destroy(&objects, handles[i]) && !cat_object_pool_destroy(&objects, handles[i]);
+    for (i = 0; result && i < array_count(handles); ++i)
+    {
+        p_record = (cat_object_pool_test_record_t*)cat_object_pool_get(&objects, handles[i]);
+        stale += (p_record == NULL);
+        result = (i % 3 ? p_record && p_record->id == i : !p_record);
+    }
+
+    // reused slots get new generation so old handles stay stale
+    for (i = 0; result && i < array_count(handles); i += 3)
+        result = (cat_object_pool_create(&objects, &handle) != NULL) && (handle != handles[i]) && !cat_object_pool_get(&objects, handles[i]);
+
+    // dense iteration touches every live record once
+    t = cat_platform_time();
+    for (i = 0, sum = 0; result && i < objects.count; ++i)
+    {
+        p_record = (cat_object_pool_test_record_t*)cat_object_pool_at(&objects, i, &handle);
+        result = (cat_object_pool_get(&objects, handle) == p_record);
+        sum += p_record->id;
+    }
+    t = cat_platform_time() - t;
+    for (i = 0, expect = 0; i < array_count(handles); ++i)
+        expect += (i % 3 ? i : 0);
+    result = result && (sum == expect) && (objects.count == array_count(handles)) && cat_object_pool_get(&objects, CAT_OBJECT_HANDLE_NULL) == NULL;
+    printf("\nObject pool: %s (%"PRIu32" stale handles caught, %"PRIu32" records iterated in %"PRIi64" ticks)", result ? "Success" : "Failed", stale, objects.count, t);
+
+    cat_object_pool_term(&objects);
+    cat_memory_pool_term(&pool);
+}
+
+
+cat_implementation_end;
\ No newline at end of file
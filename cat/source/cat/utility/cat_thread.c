@@ -19,125 +19,1574 @@
 * Thread management implementation.
 */
 
+#ifndef _WIN32
+#define _GNU_SOURCE // sched_setaffinity, CPU_SET
+#endif // #ifndef _WIN32
 
 #include "cat/utility/cat_thread.h"
 #include "cat/cat_platform.inl"
 
 #include <threads.h>
+#include <string.h>
+#include <time.h>
 #ifdef _WIN32
 #include <Windows.h>
 #else // #ifdef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif // #else // #ifdef _WIN32
 
 
 cat_implementation_begin;
 
 
+//! \struct cat_thread_record_s
+//! \brief Registry entry of live thread; lives on thread's own stack and is linked only while thread runs.
+typedef struct cat_thread_record_s
+{
+    cat_thread_info_t           info;  //< Name, id and start time; CPU time filled on query.
+#ifdef _WIN32
+    HANDLE                      handle;//< Handle for reading CPU time.
+#else // #ifdef _WIN32
+    pthread_t                   thread;//< Thread for reading CPU clock.
+#endif // #else // #ifdef _WIN32
+    struct cat_thread_record_s* p_prev;//< Previous entry.
+    struct cat_thread_record_s* p_next;//< Next entry.
+} cat_thread_record_t;
+
+static once_flag threadRegistryOnce = ONCE_FLAG_INIT;
+static mtx_t threadRegistryLock;
+static cat_thread_record_t* threadRegistryHead;
+static cat_thread_record_t* threadRegistryTail;
+static _Thread_local cat_thread_record_t* threadRecord;
+
+static void cat_thread_internal_registry_init(void)
+{
+    mtx_init(&threadRegistryLock, mtx_plain);
+}
+
+static void cat_thread_internal_register(cat_thread_record_t* const p_record)
+{
+    // called on new thread before its function runs
+    memset(p_record, 0, sizeof(*p_record));
+    p_record->info.time_created = cat_platform_time();
+#ifdef _WIN32
+    p_record->info.tid = (uint64_t)GetCurrentThreadId();
+    p_record->handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, GetCurrentThreadId());
+#else // #ifdef _WIN32
+    p_record->info.tid = (uint64_t)syscall(SYS_gettid);
+    p_record->thread = pthread_self();
+#endif // #else // #ifdef _WIN32
+    call_once(&threadRegistryOnce, &cat_thread_internal_registry_init);
+    mtx_lock(&threadRegistryLock);
+    p_record->p_prev = threadRegistryTail;
+    if (threadRegistryTail)
+        threadRegistryTail->p_next = p_record;
+    else
+        threadRegistryHead = p_record;
+    threadRegistryTail = p_record;
+    mtx_unlock(&threadRegistryLock);
+    threadRecord = p_record;
+}
+
+static void cat_thread_internal_unregister(cat_thread_record_t* const p_record)
+{
+    // unlinked before thread ends so queries never read clock of finished thread
+    threadRecord = NULL;
+    mtx_lock(&threadRegistryLock);
+    if (p_record->p_prev)
+        p_record->p_prev->p_next = p_record->p_next;
+    else
+        threadRegistryHead = p_record->p_next;
+    if (p_record->p_next)
+        p_record->p_next->p_prev = p_record->p_prev;
+    else
+        threadRegistryTail = p_record->p_prev;
+    mtx_unlock(&threadRegistryLock);
+#ifdef _WIN32
+    if (p_record->handle)
+        CloseHandle(p_record->handle);
+#endif // #ifdef _WIN32
+}
+
+static uint64_t cat_thread_internal_cpu_time(cat_thread_record_t const* const p_record)
+{
+    // user plus kernel time; registry lock keeps thread alive
+#ifdef _WIN32
+    FILETIME created = { 0 }, exited = { 0 }, kernel = { 0 }, user = { 0 };
+    if (!p_record->handle || !GetThreadTimes(p_record->handle, &created, &exited, &kernel, &user))
+        return 0;
+    return ((((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime)
+        + (((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime)) * 100;
+#else // #ifdef _WIN32
+    // calling thread reads own clock directly, others through their clock id
+    struct timespec time = { 0 };
+    clockid_t clock = CLOCK_THREAD_CPUTIME_ID;
+    if (!pthread_equal(p_record->thread, pthread_self()) && pthread_getcpuclockid(p_record->thread, &clock) != 0)
+        return 0;
+    if (clock_gettime(clock, &time) != 0)
+        return 0;
+    return ((uint64_t)time.tv_sec * 1000000000u + (uint64_t)time.tv_nsec);
+#endif // #else // #ifdef _WIN32
+}
+
 static int cat_thrd_internal_entry_point(cat_thread_params_t const* const p_thread_params)
 {
+    cat_thread_record_t record;
+    int result = 0;
     assert_or_bail(p_thread_params) 1;
     assert_or_bail(p_thread_params->func) 1;
     assert_or_bail((p_thread_params->argc == 0) || p_thread_params->argv) 1;
-    return p_thread_params->func(p_thread_params->argc, p_thread_params->argv);
+    cat_thread_internal_register(&record);
+    result = p_thread_params->func(p_thread_params->argc, p_thread_params->argv);
+    cat_thread_internal_unregister(&record);
+    return result;
+}
+
+static size_t cat_thread_internal_load(size_t volatile const* const p_value)
+{
+    // acquire: writes published before matching release are visible after
+#ifdef _WIN32
+    // volatile read is acquire under /volatile:ms, default on x86 and x64
+    return *p_value;
+#else // #ifdef _WIN32
+    return __atomic_load_n(p_value, __ATOMIC_ACQUIRE);
+#endif // #else // #ifdef _WIN32
+}
+
+static void* cat_thread_internal_load_ptr(void* volatile const* const p_value)
+{
+    // acquire: pointed-to writes published before matching release are visible after
+#ifdef _WIN32
+    // volatile read is acquire under /volatile:ms, default on x86 and x64
+    return *p_value;
+#else // #ifdef _WIN32
+    return __atomic_load_n(p_value, __ATOMIC_ACQUIRE);
+#endif // #else // #ifdef _WIN32
+}
+
+static void cat_thread_internal_store(size_t volatile* const p_value, size_t const value)
+{
+    // release: publishes all prior writes to thread that acquires value
+#ifdef _WIN32
+    // volatile write is release under /volatile:ms, default on x86 and x64
+    *p_value = value;
+#else // #ifdef _WIN32
+    __atomic_store_n(p_value, value, __ATOMIC_RELEASE);
+#endif // #else // #ifdef _WIN32
+}
+
+static bool cat_thread_internal_cas(size_t volatile* const p_value, size_t* const p_expected, size_t const desired)
+{
+    // on failure expected receives current value
+#ifdef _WIN32
+#ifdef _WIN64
+    size_t const found = (size_t)InterlockedCompareExchange64((LONG64 volatile*)p_value, (LONG64)desired, (LONG64)*p_expected);
+#else // #ifdef _WIN64
+    size_t const found = (size_t)InterlockedCompareExchange((LONG volatile*)p_value, (LONG)desired, (LONG)*p_expected);
+#endif // #else // #ifdef _WIN64
+    if (found == *p_expected)
+        return true;
+    *p_expected = found;
+    return false;
+#else // #ifdef _WIN32
+    return __atomic_compare_exchange_n(p_value, p_expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif // #else // #ifdef _WIN32
+}
+
+static bool cat_thread_internal_cas_ptr(void* volatile* const p_value, void** const p_expected, void* const desired)
+{
+    // on failure expected receives current value
+#ifdef _WIN32
+    void* const found = InterlockedCompareExchangePointer(p_value, desired, *p_expected);
+    if (found == *p_expected)
+        return true;
+    *p_expected = found;
+    return false;
+#else // #ifdef _WIN32
+    return __atomic_compare_exchange_n(p_value, p_expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif // #else // #ifdef _WIN32
+}
+
+static size_t cat_thread_internal_add(size_t volatile* const p_value, size_t const delta)
+{
+    // full barrier; returns new value, subtract by adding negated delta
+#ifdef _WIN32
+#ifdef _WIN64
+    return ((size_t)InterlockedExchangeAdd64((LONG64 volatile*)p_value, (LONG64)delta) + delta);
+#else // #ifdef _WIN64
+    return ((size_t)InterlockedExchangeAdd((LONG volatile*)p_value, (LONG)delta) + delta);
+#endif // #else // #ifdef _WIN64
+#else // #ifdef _WIN32
+    return __atomic_add_fetch(p_value, delta, __ATOMIC_SEQ_CST);
+#endif // #else // #ifdef _WIN32
+}
+
+static void cat_thread_internal_fence(void)
+{
+    // orders prior stores before later loads, which acquire and release alone do not
+#ifdef _WIN32
+    MemoryBarrier();
+#else // #ifdef _WIN32
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif // #else // #ifdef _WIN32
+}
+
+static void cat_thread_internal_pause(void)
+{
+    // spin-wait hint so sibling hyperthread gets pipeline
+#ifdef _WIN32
+    YieldProcessor();
+#elif (defined __x86_64__ || defined __i386__)
+    __builtin_ia32_pause();
+#endif // #elif (defined __x86_64__ || defined __i386__)
+}
+
+static size_t cat_thread_internal_pow2(size_t const count)
+{
+    size_t result = 1;
+    while (result < count)
+        result *= 2;
+    return result;
+}
+
+static void cat_thread_internal_spsc_copy_in(cat_thread_spsc_t* const p_ring, size_t const position, uint8_t const* const p_elements, size_t const count)
+{
+    // run may wrap past end of storage
+    size_t const index = position & p_ring->mask, first = (count < p_ring->mask + 1 - index ? count : p_ring->mask + 1 - index);
+    memcpy(p_ring->p_data + index * p_ring->element_size, p_elements, first * p_ring->element_size);
+    memcpy(p_ring->p_data, p_elements + first * p_ring->element_size, (count - first) * p_ring->element_size);
+}
+
+static void cat_thread_internal_spsc_copy_out(cat_thread_spsc_t const* const p_ring, size_t const position, uint8_t* const p_elements, size_t const count)
+{
+    size_t const index = position & p_ring->mask, first = (count < p_ring->mask + 1 - index ? count : p_ring->mask + 1 - index);
+    memcpy(p_elements, p_ring->p_data + index * p_ring->element_size, first * p_ring->element_size);
+    memcpy(p_elements + first * p_ring->element_size, p_ring->p_data, (count - first) * p_ring->element_size);
+}
+
+static uint8_t* cat_thread_internal_mpmc_cell(cat_thread_mpmc_t const* const p_ring, size_t const position)
+{
+    return (p_ring->p_cell + (position & p_ring->mask) * p_ring->cell_size);
+}
+
+static size_t cat_thread_internal_mpmc_sequence(cat_thread_mpmc_t const* const p_ring, size_t const position)
+{
+    // cell at position is free for producer of position when equal to it, ready for consumer when one more
+    return cat_thread_internal_load((size_t volatile const*)cat_thread_internal_mpmc_cell(p_ring, position));
+}
+
+//! \struct cat_thread_pinned_s
+//! \brief Start block of pinned thread; owned and released by new thread.
+typedef struct cat_thread_pinned_s
+{
+    cat_thread_params_t params;//< Thread function and arguments.
+    cat_thread_cpuset_t cpuset;//< Processors to run on.
+} cat_thread_pinned_t;
+
+static int cat_thrd_internal_pinned_entry_point(void* const p_arg)
+{
+    // pin before running so no work lands on wrong processor
+    cat_thread_pinned_t pinned = { 0 };
+    assert_or_bail(p_arg) 1;
+    pinned = *(cat_thread_pinned_t const*)p_arg;
+    cat_free(p_arg);
+    cat_thread_affinity_set(&pinned.cpuset);
+    return cat_thrd_internal_entry_point(&pinned.params);
+}
+
+#ifndef _WIN32
+static bool cat_thread_internal_read_index(size_t* const p_value_out, char const* const format, size_t const index)
+{
+    // single number from sysfs file
+    char path[128];
+    unsigned long value = 0;
+    FILE* p_file = NULL;
+    snprintf(path, sizeof(path), format, index);
+    p_file = fopen(path, "r");
+    if (!p_file)
+        return false;
+    if (fscanf(p_file, "%lu", &value) != 1)
+        value = 0;
+    fclose(p_file);
+    *p_value_out = (size_t)value;
+    return true;
+}
+
+static bool cat_thread_internal_read_list(cat_thread_cpuset_t* const p_cpuset_out, char const* const format, size_t const index)
+{
+    // sysfs list such as "0-3,8-11"
+    char path[128];
+    unsigned long first = 0, last = 0, cpu = 0;
+    int separator = 0;
+    FILE* p_file = NULL;
+    snprintf(path, sizeof(path), format, index);
+    p_file = fopen(path, "r");
+    if (!p_file)
+        return false;
+    memset(p_cpuset_out, 0, sizeof(*p_cpuset_out));
+    while (fscanf(p_file, "%lu", &first) == 1)
+    {
+        last = first;
+        separator = fgetc(p_file);
+        if (separator == '-' && fscanf(p_file, "%lu", &last) == 1)
+            separator = fgetc(p_file);
+        for (cpu = first; cpu <= last && cpu < CAT_THREAD_CPU_MAX; ++cpu)
+            cat_thread_cpuset_add(p_cpuset_out, cpu);
+        if (separator != ',')
+            break;
+    }
+    fclose(p_file);
+    return true;
+}
+#endif // #ifndef _WIN32
+
+
+cat_impl int cat_thrd_create(thrd_t* const p_thread_out, cat_thread_params_t const* const p_thread_params)
+{
+    assert_or_bail(p_thread_out) thrd_error;
+    assert_or_bail(p_thread_params) thrd_error;
+    return thrd_create(p_thread_out, &cat_thrd_internal_entry_point, (void*)p_thread_params);
+}
+
+cat_impl bool cat_thread_rename(cstr_t const name)
+{
+    bool result = false;
+    size_t length = 0;
+    assert_or_bail(name) false;
+    length = strlen(name);
+    if (length > CAT_THREAD_NAME_MAX - 1)
+        length = CAT_THREAD_NAME_MAX - 1;
+#ifdef _WIN32
+    // Thread rename: 
+    // https://learn.microsoft.com/en-us/previous-versions/visualstudio/visual-studio-2015/debugger/how-to-set-a-thread-name-in-native-code?view=vs-2015&redirectedfrom=MSDN
+    {
+#pragma warning(push)
+#pragma warning(disable: 4820 6320 6322)// suppress warnings
+#pragma pack(push, 8) // 8-bit alignment
+	    // name change structure: 
+	    // declare a data structure that can be used internally
+        struct tagTHREADNAME_INFO
+        {
+            DWORD  type;    // reserved (must be 0x1000)
+            LPCSTR name;    // name string (provided by caller)
+            DWORD  threadID;// thread ID (-1 for calling thread)
+            DWORD  flags;   // reserved (must be zero)
+        } const info = { 0x1000, name, (DWORD)(-1), 0 };
+#pragma pack(pop)
+        __try
+        {
+            // attempt name change
+            DWORD const exception = 0x406D1388;
+            RaiseException(exception, 0,
+                (sizeof(info) / sizeof(ULONG_PTR)),
+                (ULONG_PTR const*)(&info));
+        }
+        __except (EXCEPTION_EXECUTE_HANDLER)
+        {
+            // unhandled exception
+        }
+        result = true;
+#pragma warning(pop)
+    }
+#else // #ifdef _WIN32
+    {
+        // kernel rejects names longer than 15 characters instead of truncating
+        char truncated[CAT_THREAD_NAME_MAX] = { 0 };
+        memcpy(truncated, name, length);
+        result = (pthread_setname_np(pthread_self(), truncated) == 0);
+    }
+#endif // #else // #ifdef _WIN32
+    if (threadRecord)
+    {
+        mtx_lock(&threadRegistryLock);
+        memcpy(threadRecord->info.name, name, length);
+        threadRecord->info.name[length] = 0;
+        mtx_unlock(&threadRegistryLock);
+    }
+    return result;
+}
+
+cat_impl size_t cat_thread_registry_query(cat_thread_info_t* const p_info_out, size_t const capacity)
+{
+    cat_thread_record_t const* p_record = NULL;
+    size_t count = 0;
+    assert_or_bail(p_info_out || !capacity) 0;
+    call_once(&threadRegistryOnce, &cat_thread_internal_registry_init);
+    mtx_lock(&threadRegistryLock);
+    for (p_record = threadRegistryHead; p_record; p_record = p_record->p_next, ++count)
+    {
+        if (count >= capacity)
+            continue;
+        p_info_out[count] = p_record->info;
+        p_info_out[count].time_cpu_ns = cat_thread_internal_cpu_time(p_record);
+    }
+    mtx_unlock(&threadRegistryLock);
+    return count;
+}
+
+cat_impl int cat_thrd_create_pinned(thrd_t* const p_thread_out, cat_thread_params_t const* const p_thread_params, cat_thread_cpuset_t const* const p_cpuset)
+{
+    cat_thread_pinned_t* p_pinned = NULL;
+    assert_or_bail(p_thread_out) thrd_error;
+    assert_or_bail(p_thread_params) thrd_error;
+    assert_or_bail(p_cpuset) thrd_error;
+    p_pinned = (cat_thread_pinned_t*)cat_malloc(sizeof(cat_thread_pinned_t));
+    if (!p_pinned)
+        return thrd_nomem;
+    p_pinned->params = *p_thread_params;
+    p_pinned->cpuset = *p_cpuset;
+    if (thrd_create(p_thread_out, &cat_thrd_internal_pinned_entry_point, p_pinned) != thrd_success)
+    {
+        cat_free(p_pinned);
+        return thrd_error;
+    }
+    return thrd_success;
 }
 
+cat_impl bool cat_thread_affinity_set(cat_thread_cpuset_t const* const p_cpuset)
+{
+    size_t i = 0;
+    assert_or_bail(p_cpuset) false;
+#ifdef _WIN32
+    {
+        // thread runs in one processor group at a time
+        GROUP_AFFINITY affinity = { 0 };
+        for (i = 0; i < CAT_THREAD_CPU_MAX / 64; ++i)
+            if (p_cpuset->bits[i] && (i < GetActiveProcessorGroupCount()))
+                break;
+        if (i == CAT_THREAD_CPU_MAX / 64)
+            return false;
+        affinity.Mask = (KAFFINITY)p_cpuset->bits[i];
+        affinity.Group = (WORD)i;
+        return (SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL) != FALSE);
+    }
+#else // #ifdef _WIN32
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (i = 0; i < CAT_THREAD_CPU_MAX && i < CPU_SETSIZE; ++i)
+            if (cat_thread_cpuset_has(p_cpuset, i))
+                CPU_SET(i, &set);
+        return (CPU_COUNT(&set) && sched_setaffinity(0, sizeof(set), &set) == 0);
+    }
+#endif // #else // #ifdef _WIN32
+}
+
+cat_impl bool cat_thread_affinity_get(cat_thread_cpuset_t* const p_cpuset_out)
+{
+    assert_or_bail(p_cpuset_out) false;
+    memset(p_cpuset_out, 0, sizeof(*p_cpuset_out));
+#ifdef _WIN32
+    {
+        GROUP_AFFINITY affinity = { 0 };
+        if (!GetThreadGroupAffinity(GetCurrentThread(), &affinity) || affinity.Group >= CAT_THREAD_CPU_MAX / 64)
+            return false;
+        p_cpuset_out->bits[affinity.Group] = (uint64_t)affinity.Mask;
+        return true;
+    }
+#else // #ifdef _WIN32
+    {
+        cpu_set_t set;
+        size_t i = 0;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0)
+            return false;
+        for (i = 0; i < CAT_THREAD_CPU_MAX && i < CPU_SETSIZE; ++i)
+            if (CPU_ISSET(i, &set))
+                cat_thread_cpuset_add(p_cpuset_out, i);
+        return true;
+    }
+#endif // #else // #ifdef _WIN32
+}
+
+cat_impl bool cat_thread_topology(cat_thread_topology_t* const p_topology_out)
+{
+    size_t cpu = 0, node = 0, core = 0;
+    assert_or_bail(p_topology_out) false;
+    memset(p_topology_out, 0, sizeof(*p_topology_out));
+#ifdef _WIN32
+    {
+        // cores and nodes come as group masks; processor index is group times 64 plus bit
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* p_info = NULL;
+        uint8_t* p_buffer = NULL;
+        DWORD size = 0, offset = 0;
+        WORD group = 0;
+        size_t index = 0;
+        GetLogicalProcessorInformationEx(RelationAll, NULL, &size);
+        p_buffer = (uint8_t*)cat_malloc(size);
+        if (!p_buffer)
+            return false;
+        if (!GetLogicalProcessorInformationEx(RelationAll, (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)p_buffer, &size))
+        {
+            cat_free(p_buffer);
+            return false;
+        }
+        for (offset = 0; offset < size; offset += p_info->Size)
+        {
+            p_info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)(p_buffer + offset);
+            if (p_info->Relationship == RelationProcessorCore)
+            {
+                for (group = 0; group < p_info->Processor.GroupCount; ++group)
+                    for (cpu = 0; cpu < 64; ++cpu)
+                        if ((p_info->Processor.GroupMask[group].Mask >> cpu) & 1)
+                        {
+                            index = p_info->Processor.GroupMask[group].Group * 64 + cpu;
+                            if (cat_thread_cpuset_add(&p_topology_out->available, index))
+                                p_topology_out->core[index] = (uint16_t)core;
+                        }
+                ++core;
+            }
+        }
+        for (offset = 0; offset < size; offset += p_info->Size)
+        {
+            p_info = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)(p_buffer + offset);
+            if (p_info->Relationship == RelationNumaNode)
+            {
+                node = p_info->NumaNode.NodeNumber;
+                for (cpu = 0; cpu < 64; ++cpu)
+                {
+                    index = p_info->NumaNode.GroupMask.Group * 64 + cpu;
+                    if (((p_info->NumaNode.GroupMask.Mask >> cpu) & 1) && (index < CAT_THREAD_CPU_MAX))
+                        p_topology_out->node[index] = (uint16_t)node;
+                }
+            }
+        }
+        cat_free(p_buffer);
+    }
+#else // #ifdef _WIN32
+    {
+        // core id is only unique within package, so cores are renumbered by package and id
+        size_t key[CAT_THREAD_CPU_MAX], package = 0, id = 0, num_keys = 0;
+        cat_thread_cpuset_t node_cpus = { 0 };
+        if (!cat_thread_affinity_get(&p_topology_out->available))
+            return false;
+        for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
+        {
+            if (!cat_thread_cpuset_has(&p_topology_out->available, cpu))
+                continue;
+            if (!cat_thread_internal_read_index(&package, "/sys/devices/system/cpu/cpu%zu/topology/physical_package_id", cpu)
+                || !cat_thread_internal_read_index(&id, "/sys/devices/system/cpu/cpu%zu/topology/core_id", cpu))
+                package = id = cpu;
+            for (core = 0; core < num_keys; ++core)
+                if (key[core] == ((package << 20) | id))
+                    break;
+            if (core == num_keys)
+                key[num_keys++] = ((package << 20) | id);
+            p_topology_out->core[cpu] = (uint16_t)core;
+        }
+        for (node = 0; node < CAT_THREAD_CPU_MAX; ++node)
+        {
+            if (!cat_thread_internal_read_list(&node_cpus, "/sys/devices/system/node/node%zu/cpulist", node))
+                continue;
+            for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
+                if (cat_thread_cpuset_has(&node_cpus, cpu))
+                    p_topology_out->node[cpu] = (uint16_t)node;
+        }
+    }
+#endif // #else // #ifdef _WIN32
+    for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
+    {
+        if (!cat_thread_cpuset_has(&p_topology_out->available, cpu))
+            continue;
+        ++p_topology_out->num_cpus;
+        if (p_topology_out->num_nodes <= p_topology_out->node[cpu])
+            p_topology_out->num_nodes = (size_t)p_topology_out->node[cpu] + 1;
+    }
+    if (!p_topology_out->num_nodes)
+        p_topology_out->num_nodes = 1;
+    return (p_topology_out->num_cpus != 0);
+}
+
+cat_impl size_t cat_thread_current_node(void)
+{
+#ifdef _WIN32
+    PROCESSOR_NUMBER processor = { 0 };
+    USHORT node = 0;
+    GetCurrentProcessorNumberEx(&processor);
+    if (!GetNumaProcessorNodeEx(&processor, &node) || node == (USHORT)(-1))
+        node = 0;
+    return (size_t)node;
+#else // #ifdef _WIN32
+    unsigned int cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+        node = 0;
+    return (size_t)node;
+#endif // #else // #ifdef _WIN32
+}
+
+cat_impl bool cat_thread_cpuset_add(cat_thread_cpuset_t* const p_cpuset, size_t const cpu)
+{
+    assert_or_bail(p_cpuset) false;
+    if (cpu >= CAT_THREAD_CPU_MAX)
+        return false;
+    p_cpuset->bits[cpu / 64] |= ((uint64_t)1 << (cpu % 64));
+    return true;
+}
+
+cat_impl bool cat_thread_cpuset_has(cat_thread_cpuset_t const* const p_cpuset, size_t const cpu)
+{
+    assert_or_bail(p_cpuset) false;
+    return ((cpu < CAT_THREAD_CPU_MAX) && ((p_cpuset->bits[cpu / 64] >> (cpu % 64)) & 1));
+}
+
+cat_impl bool cat_thread_spsc_init(cat_thread_spsc_t* const p_ring, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity)
+{
+    size_t const count = cat_thread_internal_pow2(capacity);
+    assert_or_bail(p_ring) false;
+    assert_or_bail(element_size) false;
+    assert_or_bail(capacity && capacity <= SIZE_MAX / 2 / element_size) false;
+    memset(p_ring, 0, sizeof(*p_ring));
+    p_ring->allocator = (p_allocator ? *p_allocator : cat_memory_allocator_heap());
+    p_ring->p_data = (uint8_t*)cat_memory_allocator_alloc(&p_ring->allocator, count * element_size);
+    if (!p_ring->p_data)
+        return false;
+    p_ring->element_size = element_size;
+    p_ring->mask = count - 1;
+    return true;
+}
+
+cat_impl bool cat_thread_spsc_term(cat_thread_spsc_t* const p_ring)
+{
+    assert_or_bail(p_ring) false;
+    if (p_ring->p_data)
+        cat_memory_allocator_dealloc(&p_ring->allocator, p_ring->p_data, (p_ring->mask + 1) * p_ring->element_size);
+    memset(p_ring, 0, sizeof(*p_ring));
+    return true;
+}
+
+cat_impl bool cat_thread_spsc_enqueue(cat_thread_spsc_t* const p_ring, void const* const p_element)
+{
+    size_t head = 0;
+    assert_or_bail(p_ring) false;
+    assert_or_bail(p_element) false;
+    head = p_ring->head;
+    if (head - p_ring->tail_cached > p_ring->mask)
+    {
+        // looks full: only now read consumer's index
+        p_ring->tail_cached = cat_thread_internal_load(&p_ring->tail);
+        if (head - p_ring->tail_cached > p_ring->mask)
+            return false;
+    }
+    memcpy(p_ring->p_data + (head & p_ring->mask) * p_ring->element_size, p_element, p_ring->element_size);
+    cat_thread_internal_store(&p_ring->head, head + 1);
+    return true;
+}
+
+cat_impl bool cat_thread_spsc_dequeue(cat_thread_spsc_t* const p_ring, void* const p_element_out)
+{
+    size_t tail = 0;
+    assert_or_bail(p_ring) false;
+    assert_or_bail(p_element_out) false;
+    tail = p_ring->tail;
+    if (tail == p_ring->head_cached)
+    {
+        // looks empty: only now read producer's index
+        p_ring->head_cached = cat_thread_internal_load(&p_ring->head);
+        if (tail == p_ring->head_cached)
+            return false;
+    }
+    memcpy(p_element_out, p_ring->p_data + (tail & p_ring->mask) * p_ring->element_size, p_ring->element_size);
+    cat_thread_internal_store(&p_ring->tail, tail + 1);
+    return true;
+}
+
+cat_impl size_t cat_thread_spsc_enqueue_batch(cat_thread_spsc_t* const p_ring, void const* const p_elements, size_t const count)
+{
+    size_t head = 0, space = 0;
+    assert_or_bail(p_ring) 0;
+    assert_or_bail(p_elements || !count) 0;
+    head = p_ring->head;
+    space = p_ring->mask + 1 - (head - p_ring->tail_cached);
+    if (space < count)
+    {
+        p_ring->tail_cached = cat_thread_internal_load(&p_ring->tail);
+        space = p_ring->mask + 1 - (head - p_ring->tail_cached);
+    }
+    if (space > count)
+        space = count;
+    if (space)
+    {
+        cat_thread_internal_spsc_copy_in(p_ring, head, (uint8_t const*)p_elements, space);
+        cat_thread_internal_store(&p_ring->head, head + space);
+    }
+    return space;
+}
+
+cat_impl size_t cat_thread_spsc_dequeue_batch(cat_thread_spsc_t* const p_ring, void* const p_elements_out, size_t const count)
+{
+    size_t tail = 0, ready = 0;
+    assert_or_bail(p_ring) 0;
+    assert_or_bail(p_elements_out || !count) 0;
+    tail = p_ring->tail;
+    ready = p_ring->head_cached - tail;
+    if (ready < count)
+    {
+        p_ring->head_cached = cat_thread_internal_load(&p_ring->head);
+        ready = p_ring->head_cached - tail;
+    }
+    if (ready > count)
+        ready = count;
+    if (ready)
+    {
+        cat_thread_internal_spsc_copy_out(p_ring, tail, (uint8_t*)p_elements_out, ready);
+        cat_thread_internal_store(&p_ring->tail, tail + ready);
+    }
+    return ready;
+}
+
+cat_impl bool cat_thread_mpmc_init(cat_thread_mpmc_t* const p_ring, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity)
+{
+    size_t const count = cat_thread_internal_pow2(capacity < 2 ? 2 : capacity);
+    size_t const cell_size = (sizeof(size_t) + element_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    size_t i = 0;
+    assert_or_bail(p_ring) false;
+    assert_or_bail(element_size) false;
+    assert_or_bail(capacity && capacity <= SIZE_MAX / 2 / cell_size) false;
+    memset(p_ring, 0, sizeof(*p_ring));
+    p_ring->allocator = (p_allocator ? *p_allocator : cat_memory_allocator_heap());
+    p_ring->p_cell = (uint8_t*)cat_memory_allocator_alloc(&p_ring->allocator, count * cell_size);
+    if (!p_ring->p_cell)
+        return false;
+    p_ring->element_size = element_size;
+    p_ring->cell_size = cell_size;
+    p_ring->mask = count - 1;
+    for (i = 0; i < count; ++i)
+        *(size_t*)(p_ring->p_cell + i * cell_size) = i;
+    return true;
+}
+
+cat_impl bool cat_thread_mpmc_term(cat_thread_mpmc_t* const p_ring)
+{
+    assert_or_bail(p_ring) false;
+    if (p_ring->p_cell)
+        cat_memory_allocator_dealloc(&p_ring->allocator, p_ring->p_cell, (p_ring->mask + 1) * p_ring->cell_size);
+    memset(p_ring, 0, sizeof(*p_ring));
+    return true;
+}
+
+cat_impl bool cat_thread_mpmc_enqueue(cat_thread_mpmc_t* const p_ring, void const* const p_element)
+{
+    return (cat_thread_mpmc_enqueue_batch(p_ring, p_element, 1) == 1);
+}
+
+cat_impl bool cat_thread_mpmc_dequeue(cat_thread_mpmc_t* const p_ring, void* const p_element_out)
+{
+    return (cat_thread_mpmc_dequeue_batch(p_ring, p_element_out, 1) == 1);
+}
+
+cat_impl size_t cat_thread_mpmc_enqueue_batch(cat_thread_mpmc_t* const p_ring, void const* const p_elements, size_t const count)
+{
+    size_t position = 0, sequence = 0, claimed = 0, i = 0;
+    uint8_t* p_cell = NULL;
+    assert_or_bail(p_ring) 0;
+    assert_or_bail(p_elements || !count) 0;
+    if (!count)
+        return 0;
+    position = cat_thread_internal_load(&p_ring->head);
+    for (;;)
+    {
+        // count free cells from head; none can be taken by others unless head moves, which fails exchange
+        for (claimed = 0; claimed < count && claimed <= p_ring->mask; ++claimed)
+        {
+            sequence = cat_thread_internal_mpmc_sequence(p_ring, position + claimed);
+            if (sequence != position + claimed)
+                break;
+        }
+        if (claimed)
+        {
+            if (cat_thread_internal_cas(&p_ring->head, &position, position + claimed))
+                break;
+        }
+        else if ((intptr_t)(sequence - position) < 0)
+            return 0;
+        else
+            position = cat_thread_internal_load(&p_ring->head);
+    }
+    for (i = 0; i < claimed; ++i)
+    {
+        p_cell = cat_thread_internal_mpmc_cell(p_ring, position + i);
+        memcpy(p_cell + sizeof(size_t), (uint8_t const*)p_elements + i * p_ring->element_size, p_ring->element_size);
+        cat_thread_internal_store((size_t volatile*)p_cell, position + i + 1);
+    }
+    return claimed;
+}
+
+cat_impl size_t cat_thread_mpmc_dequeue_batch(cat_thread_mpmc_t* const p_ring, void* const p_elements_out, size_t const count)
+{
+    size_t position = 0, sequence = 0, claimed = 0, i = 0;
+    uint8_t* p_cell = NULL;
+    assert_or_bail(p_ring) 0;
+    assert_or_bail(p_elements_out || !count) 0;
+    if (!count)
+        return 0;
+    position = cat_thread_internal_load(&p_ring->tail);
+    for (;;)
+    {
+        // count ready cells from tail; same reasoning as enqueue
+        for (claimed = 0; claimed < count && claimed <= p_ring->mask; ++claimed)
+        {
+            sequence = cat_thread_internal_mpmc_sequence(p_ring, position + claimed);
+            if (sequence != position + claimed + 1)
+                break;
+        }
+        if (claimed)
+        {
+            if (cat_thread_internal_cas(&p_ring->tail, &position, position + claimed))
+                break;
+        }
+        else if ((intptr_t)(sequence - (position + 1)) < 0)
+            return 0;
+        else
+            position = cat_thread_internal_load(&p_ring->tail);
+    }
+    for (i = 0; i < claimed; ++i)
+    {
+        // cell becomes free for producer one lap later
+        p_cell = cat_thread_internal_mpmc_cell(p_ring, position + i);
+        memcpy((uint8_t*)p_elements_out + i * p_ring->element_size, p_cell + sizeof(size_t), p_ring->element_size);
+        cat_thread_internal_store((size_t volatile*)p_cell, position + i + p_ring->mask + 1);
+    }
+    return claimed;
+}
+
+
+static _Thread_local cat_thread_worker_t* threadWorker;
+static cat_thread_completion_t threadCompletionClosed;
+
+
+static bool cat_mngr_internal_push(cat_thread_worker_t* const p_worker, cat_thread_task_t const* const p_task)
+{
+    // owner only; slot is free while bottom is less than one lap ahead of top
+    size_t const bottom = p_worker->bottom, top = cat_thread_internal_load(&p_worker->top);
+    if (bottom - top > p_worker->mask)
+        return false;
+    p_worker->p_task[bottom & p_worker->mask] = *p_task;
+    cat_thread_internal_store(&p_worker->bottom, bottom + 1);
+    return true;
+}
+
+static bool cat_mngr_internal_pop(cat_thread_worker_t* const p_worker, cat_thread_task_t* const p_task_out)
+{
+    // owner only; reserve newest task by lowering bottom, then race thieves only if it was last one
+    size_t const bottom = p_worker->bottom - 1;
+    size_t top = 0;
+    bool result = true;
+    cat_thread_internal_store(&p_worker->bottom, bottom);
+    cat_thread_internal_fence();
+    top = cat_thread_internal_load(&p_worker->top);
+    if ((intptr_t)(bottom - top) < 0)
+    {
+        cat_thread_internal_store(&p_worker->bottom, bottom + 1);
+        return false;
+    }
+    *p_task_out = p_worker->p_task[bottom & p_worker->mask];
+    if (bottom == top)
+    {
+        result = cat_thread_internal_cas(&p_worker->top, &top, top + 1);
+        cat_thread_internal_store(&p_worker->bottom, bottom + 1);
+    }
+    return result;
+}
+
+static bool cat_mngr_internal_steal(cat_thread_worker_t* const p_victim, cat_thread_task_t* const p_task_out)
+{
+    // any thread; copy is discarded unless exchange proves owner did not reuse slot meanwhile
+    size_t top = cat_thread_internal_load(&p_victim->top), bottom = 0;
+    cat_thread_internal_fence();
+    bottom = cat_thread_internal_load(&p_victim->bottom);
+    if ((intptr_t)(bottom - top) <= 0)
+        return false;
+    *p_task_out = p_victim->p_task[top & p_victim->mask];
+    return cat_thread_internal_cas(&p_victim->top, &top, top + 1);
+}
+
+static bool cat_mngr_internal_find(cat_thread_manager_t* const p_thread_manager, cat_thread_worker_t* const p_worker, cat_thread_task_t* const p_task_out)
+{
+    // own newest task first, then shared queue, then oldest task of other workers starting at random one
+    size_t i = 0, first = 0;
+    if (p_worker && cat_mngr_internal_pop(p_worker, p_task_out))
+        return true;
+    if (cat_thread_mpmc_dequeue(&p_thread_manager->queue, p_task_out))
+        return true;
+    if (p_worker)
+    {
+        p_worker->seed ^= p_worker->seed << 13;
+        p_worker->seed ^= p_worker->seed >> 7;
+        p_worker->seed ^= p_worker->seed << 17;
+        first = (size_t)(p_worker->seed % p_thread_manager->num_threads);
+    }
+    for (i = 0; i < p_thread_manager->num_threads; ++i)
+    {
+        cat_thread_worker_t* const p_victim = &p_thread_manager->p_worker[(first + i) % p_thread_manager->num_threads];
+        if (p_victim != p_worker && cat_mngr_internal_steal(p_victim, p_task_out))
+        {
+            if (p_worker)
+                ++p_worker->steals;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void cat_mngr_internal_submit(cat_thread_manager_t* const p_thread_manager, cat_thread_task_t const* const p_task);
+
+static void cat_mngr_internal_complete(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t* const p_completion, int const result)
+{
+    // close continuation list before marking finished so chaining either lands in list or sees it closed and submits itself;
+    // handle may be released as soon as it reads finished, so it is not touched after that
+    cat_thread_completion_t* p_continuation = NULL, * p_next = NULL;
+    cat_thread_task_t task = { 0 };
+    p_completion->result = result;
+    p_continuation = (cat_thread_completion_t*)cat_thread_internal_load_ptr((void* volatile const*)&p_completion->p_continuation);
+    while (!cat_thread_internal_cas_ptr((void* volatile*)&p_completion->p_continuation, (void**)&p_continuation, &threadCompletionClosed));
+    cat_thread_internal_store(&p_completion->finished, 1);
+    for (; p_continuation; p_continuation = p_next)
+    {
+        p_next = p_continuation->p_next;
+        task.params = p_continuation->params;
+        task.p_group = &p_thread_manager->group;
+        task.p_completion = p_continuation;
+        cat_mngr_internal_submit(p_thread_manager, &task);
+    }
+    cat_thread_internal_fence();
+    if (cat_thread_internal_load(&p_thread_manager->waiting))
+    {
+        mtx_lock(&p_thread_manager->lock);
+        cnd_broadcast(&p_thread_manager->done);
+        mtx_unlock(&p_thread_manager->lock);
+    }
+}
+
+static void cat_mngr_internal_run(cat_thread_manager_t* const p_thread_manager, cat_thread_task_t const* const p_task)
+{
+    // task runs on worker's thread and registry record, so called directly; last task of manager's own group wakes joiners
+    cat_thread_group_t* const p_group = p_task->p_group;
+    int result = 1;
+    assert(p_task->params.func && ((p_task->params.argc == 0) || p_task->params.argv));
+    if (p_task->params.func && ((p_task->params.argc == 0) || p_task->params.argv))
+        result = p_task->params.func(p_task->params.argc, p_task->params.argv);
+    if (result)
+        cat_thread_internal_add(&p_group->failed, 1);
+    if (p_task->p_completion)
+        cat_mngr_internal_complete(p_thread_manager, p_task->p_completion, result);
+    if (!cat_thread_internal_add(&p_group->pending, (size_t)-1) && p_group == &p_thread_manager->group)
+    {
+        mtx_lock(&p_thread_manager->lock);
+        cnd_broadcast(&p_thread_manager->idle);
+        mtx_unlock(&p_thread_manager->lock);
+    }
+}
+
+static void cat_mngr_internal_notify(cat_thread_manager_t* const p_thread_manager)
+{
+    // publish new task before checking for parked workers; parking worker does opposite
+    cat_thread_internal_fence();
+    if (cat_thread_internal_load(&p_thread_manager->sleeping))
+    {
+        mtx_lock(&p_thread_manager->lock);
+        cnd_signal(&p_thread_manager->wake);
+        mtx_unlock(&p_thread_manager->lock);
+    }
+}
+
+static void cat_mngr_internal_submit(cat_thread_manager_t* const p_thread_manager, cat_thread_task_t const* const p_task)
+{
+    // task already counted in its group; from this manager's worker it goes to own deque unless full
+    cat_thread_worker_t* const p_worker = threadWorker;
+    cat_thread_task_t task_queued = { 0 };
+    if (!p_worker || p_worker->p_manager != p_thread_manager || !cat_mngr_internal_push(p_worker, p_task))
+    {
+        while (!cat_thread_mpmc_enqueue(&p_thread_manager->queue, p_task))
+        {
+            // queue full: make room by running oldest task here instead of waiting
+            if (cat_thread_mpmc_dequeue(&p_thread_manager->queue, &task_queued))
+                cat_mngr_internal_run(p_thread_manager, &task_queued);
+        }
+    }
+    cat_mngr_internal_notify(p_thread_manager);
+}
+
+static bool cat_mngr_internal_ready(cat_thread_completion_t const* const* const pp_completion, size_t const count, bool const all, size_t* const p_index_out)
+{
+    // all: every handle finished; otherwise lowest finished handle
+    size_t i = 0;
+    bool finished = false;
+    for (i = 0; i < count; ++i)
+    {
+        finished = (cat_thread_internal_load(&pp_completion[i]->finished) != 0);
+        if (all && !finished)
+            return false;
+        if (!all && finished)
+        {
+            if (p_index_out)
+                *p_index_out = i;
+            return true;
+        }
+    }
+    return all;
+}
+
+static int cat_mngr_internal_wait(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const* const pp_completion, size_t const count, bool const all,
+    uint32_t const timeout_ms, size_t* const p_index_out)
+{
+    cat_thread_worker_t* const p_worker = (threadWorker && threadWorker->p_manager == p_thread_manager ? threadWorker : NULL);
+    cat_thread_task_t task = { 0 };
+    struct timespec deadline = { 0 }, now = { 0 };
+    size_t spin = 0;
+    bool ready = false;
+    timespec_get(&deadline, TIME_UTC);
+    deadline.tv_sec += (time_t)(timeout_ms / 1000);
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000;
+    }
+    for (;;)
+    {
+        if (cat_mngr_internal_ready(pp_completion, count, all, p_index_out))
+            return thrd_success;
+        timespec_get(&now, TIME_UTC);
+        if (timeout_ms != CAT_THREAD_INFINITE && (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)))
+            return thrd_timedout;
+
+        // worker must keep running tasks, since task waited on may be queued behind it; gives up time slice once nothing is left to take
+        if (p_worker)
+        {
+            if (cat_mngr_internal_find(p_thread_manager, p_worker, &task))
+            {
+                cat_mngr_internal_run(p_thread_manager, &task);
+                spin = 0;
+            }
+            else if (++spin < CAT_THREAD_SPIN_COUNT)
+                cat_thread_internal_pause();
+            else
+                thrd_yield();
+            continue;
+        }
+        if (++spin < CAT_THREAD_SPIN_COUNT)
+        {
+            cat_thread_internal_pause();
+            continue;
+        }
+
+        // park: announce first, then check once more; finishing task checks in opposite order
+        spin = 0;
+        mtx_lock(&p_thread_manager->lock);
+        cat_thread_internal_add(&p_thread_manager->waiting, 1);
+        ready = cat_mngr_internal_ready(pp_completion, count, all, p_index_out);
+        if (!ready && timeout_ms == CAT_THREAD_INFINITE)
+            cnd_wait(&p_thread_manager->done, &p_thread_manager->lock);
+        else if (!ready)
+            cnd_timedwait(&p_thread_manager->done, &p_thread_manager->lock, &deadline);
+        cat_thread_internal_add(&p_thread_manager->waiting, (size_t)-1);
+        mtx_unlock(&p_thread_manager->lock);
+        if (ready)
+            return thrd_success;
+    }
+}
 
-cat_impl int cat_thrd_create(thrd_t* const p_thread_out, cat_thread_params_t const* const p_thread_params)
+static int cat_mngr_internal_result(cat_thread_group_t* const p_group)
 {
-    assert_or_bail(p_thread_out) thrd_error;
-    assert_or_bail(p_thread_params) thrd_error;
-    return thrd_create(p_thread_out, &cat_thrd_internal_entry_point, (void*)p_thread_params);
+    if (!cat_thread_internal_load(&p_group->failed))
+        return thrd_success;
+    cat_thread_internal_store(&p_group->failed, 0);
+    return thrd_error;
 }
 
-cat_impl void cat_mngr_create(cat_thread_manager_t* p_thread_manager_out)
+static size_t cat_mngr_internal_nodes(cat_thread_topology_t const* const p_topology, uint16_t* const p_node_out)
 {
-    for (int i = 0; i < MAX_THREADS; ++i)
+    // distinct nodes of available processors, in processor order
+    size_t cpu = 0, i = 0, count = 0;
+    for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
     {
-        thrd_t thread = { &i };
-        p_thread_manager_out->inactive[i] = &thread;
-        p_thread_manager_out->active[i] = NULL;
-        p_thread_manager_out->results[i] = 0;
+        if (!cat_thread_cpuset_has(&p_topology->available, cpu))
+            continue;
+        for (i = 0; i < count; ++i)
+            if (p_node_out[i] == p_topology->node[cpu])
+                break;
+        if (i == count)
+            p_node_out[count++] = p_topology->node[cpu];
     }
-    p_thread_manager_out->num_threads = MAX_THREADS;
-    
-
+    return count;
 }
 
-__declspec(spectre(nomitigation))
-cat_impl int cat_mngr_activate_thread(cat_thread_manager_t* p_thread_manager, cat_thread_params_t const* const p_thread_params)
+static void cat_mngr_internal_place(cat_thread_manager_t* const p_thread_manager, cat_thread_topology_t const* const p_topology)
 {
-    assert_or_bail(p_thread_manager) thrd_error;
-    assert_or_bail(p_thread_params) thrd_error;
+    // rank each processor by node, by core within node and by hyperthread within core, order by ranks, then deal out in turn;
+    // compact orders node first so neighbours share caches, scatter orders hyperthread first so workers get own cores and nodes
+    uint16_t cpus[CAT_THREAD_CPU_MAX], nodes[CAT_THREAD_CPU_MAX], cpu_sorted = 0;
+    uint32_t key[CAT_THREAD_CPU_MAX], rank_node = 0, rank_core = 0, rank_thread[CAT_THREAD_CPU_MAX], key_cpu = 0;
+    size_t const num_nodes = cat_mngr_internal_nodes(p_topology, nodes);
+    size_t num_cpus = 0, cpu = 0, first = 0, i = 0, j = 0;
+    for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
+        if (cat_thread_cpuset_has(&p_topology->available, cpu))
+            cpus[num_cpus++] = (uint16_t)cpu;
+    for (i = 0; i < num_cpus; ++i)
+    {
+        for (first = 0; p_topology->core[cpus[first]] != p_topology->core[cpus[i]]; ++first);
+        for (rank_node = 0; nodes[rank_node] != p_topology->node[cpus[i]]; ++rank_node);
+        for (rank_thread[i] = 0, j = first; j < i; ++j)
+            rank_thread[i] += (p_topology->core[cpus[j]] == p_topology->core[cpus[i]]);
+        for (rank_core = 0, j = 0; j < first; ++j)
+            rank_core += (rank_thread[j] == 0 && p_topology->node[cpus[j]] == p_topology->node[cpus[i]]);
+        if (p_thread_manager->placement == cat_thread_placement_scatter)
+            key[i] = (rank_thread[i] << 16) | (rank_core << 8) | rank_node;
+        else
+            key[i] = (rank_node << 16) | (rank_core << 8) | rank_thread[i];
+    }
+    for (i = 1; i < num_cpus; ++i)
+    {
+        cpu_sorted = cpus[i];
+        key_cpu = key[i];
+        for (j = i; j > 0 && key[j - 1] > key_cpu; --j)
+        {
+            cpus[j] = cpus[j - 1];
+            key[j] = key[j - 1];
+        }
+        cpus[j] = cpu_sorted;
+        key[j] = key_cpu;
+    }
 
-    for (int i = 0; i < p_thread_manager->num_threads; i++)
+    for (i = 0; i < p_thread_manager->num_threads; ++i)
     {
-        if (p_thread_manager->active[i] == NULL)
+        cat_thread_worker_t* const p_worker = &p_thread_manager->p_worker[i];
+        memset(&p_worker->cpuset, 0, sizeof(p_worker->cpuset));
+        if (p_thread_manager->placement == cat_thread_placement_node)
+        {
+            p_worker->node = nodes[i % num_nodes];
+            for (j = 0; j < num_cpus; ++j)
+                if (p_topology->node[cpus[j]] == p_worker->node)
+                    cat_thread_cpuset_add(&p_worker->cpuset, cpus[j]);
+        }
+        else
         {
-            p_thread_manager->active[i] = p_thread_manager->inactive[i];
-            p_thread_manager->inactive[i] = NULL;
-            p_thread_manager->results[i] = cat_thrd_create(p_thread_manager->active[i], p_thread_params);
-            return p_thread_manager->results[i];
-            
+            p_worker->node = p_topology->node[cpus[i % num_cpus]];
+            cat_thread_cpuset_add(&p_worker->cpuset, cpus[i % num_cpus]);
         }
     }
-    
-    return -1;
 }
 
-__declspec(spectre(nomitigation))
-cat_impl void cat_mngr_join_all_threads(cat_thread_manager_t* p_thread_manager)
+static int cat_mngr_internal_worker(void* const p_arg)
 {
-    for (int i = 0; i < p_thread_manager->num_threads; i++)
+    cat_thread_worker_t* const p_worker = (cat_thread_worker_t*)p_arg;
+    cat_thread_manager_t* p_thread_manager = NULL;
+    cat_thread_task_t task = { 0 };
+    cat_thread_record_t record;
+    char name[CAT_THREAD_NAME_MAX];
+    size_t spin = 0;
+    bool found = false;
+    assert_or_bail(p_worker && p_worker->p_manager) 1;
+    p_thread_manager = p_worker->p_manager;
+    threadWorker = p_worker;
+    cat_thread_internal_register(&record);
+    snprintf(name, sizeof(name), "cat worker %"PRIu32, (uint32_t)(p_worker - p_thread_manager->p_worker));
+    cat_thread_rename(name);
+    if (p_thread_manager->placement != cat_thread_placement_none)
+        cat_thread_affinity_set(&p_worker->cpuset);
+    for (;;)
     {
-        if (p_thread_manager->active[i] != NULL)
+        if (cat_mngr_internal_find(p_thread_manager, p_worker, &task))
+        {
+            cat_mngr_internal_run(p_thread_manager, &task);
+            spin = 0;
+            continue;
+        }
+        if (!cat_thread_internal_load(&p_thread_manager->running))
+            break;
+        if (++spin < CAT_THREAD_SPIN_COUNT)
         {
-            thrd_join(*p_thread_manager->active[i], &p_thread_manager->results[i]);
+            cat_thread_internal_pause();
+            continue;
         }
+
+        // park: announce first, then look once more; submitter checks in opposite order so one of us sees the other
+        spin = 0;
+        mtx_lock(&p_thread_manager->lock);
+        cat_thread_internal_add(&p_thread_manager->sleeping, 1);
+        found = cat_mngr_internal_find(p_thread_manager, p_worker, &task);
+        if (!found && cat_thread_internal_load(&p_thread_manager->running))
+            cnd_wait(&p_thread_manager->wake, &p_thread_manager->lock);
+        cat_thread_internal_add(&p_thread_manager->sleeping, (size_t)-1);
+        mtx_unlock(&p_thread_manager->lock);
+        if (found)
+            cat_mngr_internal_run(p_thread_manager, &task);
     }
+    cat_thread_internal_unregister(&record);
+    threadWorker = NULL;
+    return 0;
 }
 
-cat_impl bool cat_thread_rename(cstr_t const name)
+
+cat_impl size_t cat_thread_hardware_concurrency(void)
 {
-    bool result = false;
-    assert_or_bail(name) false;
+    size_t result = 0;
 #ifdef _WIN32
-    // Thread rename: 
-    // https://learn.microsoft.com/en-us/previous-versions/visualstudio/visual-studio-2015/debugger/how-to-set-a-thread-name-in-native-code?view=vs-2015&redirectedfrom=MSDN
+    result = (size_t)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else // #ifdef _WIN32
+    long const count = sysconf(_SC_NPROCESSORS_ONLN);
+    result = (count > 0 ? (size_t)count : 0);
+#endif // #else // #ifdef _WIN32
+    return (result ? result : 1);
+}
+
+cat_impl bool cat_mngr_create(cat_thread_manager_t* const p_thread_manager_out, size_t const num_threads, cat_thread_placement_t const placement)
+{
+    cat_thread_topology_t topology = { 0 };
+    uint16_t nodes[CAT_THREAD_CPU_MAX];
+    cat_thread_task_t* p_task = NULL;
+    size_t count = num_threads, i = 0;
+    bool wake = false, idle = false, done = false;
+    assert_or_bail(p_thread_manager_out) false;
+    memset(p_thread_manager_out, 0, sizeof(*p_thread_manager_out));
+
+    // workers float if topology is unknown
+    if (placement != cat_thread_placement_none && cat_thread_topology(&topology))
+        p_thread_manager_out->placement = placement;
+    if (!count && p_thread_manager_out->placement == cat_thread_placement_node)
+        count = cat_mngr_internal_nodes(&topology, nodes);
+    if (!count)
+        count = cat_thread_hardware_concurrency();
+    if (!cat_thread_mpmc_init(&p_thread_manager_out->queue, NULL, sizeof(cat_thread_task_t), CAT_THREAD_QUEUE_CAPACITY))
+        return false;
+    p_thread_manager_out->p_worker = (cat_thread_worker_t*)cat_calloc(count, sizeof(cat_thread_worker_t));
+    p_task = (cat_thread_task_t*)cat_calloc(count * CAT_THREAD_DEQUE_CAPACITY, sizeof(cat_thread_task_t));
+    if (!p_thread_manager_out->p_worker || !p_task
+        || mtx_init(&p_thread_manager_out->lock, mtx_plain) != thrd_success)
     {
-#pragma warning(push)
-#pragma warning(disable: 4820 6320 6322)// suppress warnings
-#pragma pack(push, 8) // 8-bit alignment
-	    // name change structure: 
-	    // declare a data structure that can be used internally
-        struct tagTHREADNAME_INFO
-        {
-            DWORD  type;    // reserved (must be 0x1000)
-            LPCSTR name;    // name string (provided by caller)
-            DWORD  threadID;// thread ID (-1 for calling thread)
-            DWORD  flags;   // reserved (must be zero)
-        } const info = { 0x1000, name, (DWORD)(-1), 0 };
-#pragma pack(pop)
-        __try
+        cat_free(p_task);
+        cat_free(p_thread_manager_out->p_worker);
+        cat_thread_mpmc_term(&p_thread_manager_out->queue);
+        return false;
+    }
+    wake = (cnd_init(&p_thread_manager_out->wake) == thrd_success);
+    idle = wake && (cnd_init(&p_thread_manager_out->idle) == thrd_success);
+    done = idle && (cnd_init(&p_thread_manager_out->done) == thrd_success);
+    if (!done)
+    {
+        if (idle)
+            cnd_destroy(&p_thread_manager_out->idle);
+        if (wake)
+            cnd_destroy(&p_thread_manager_out->wake);
+        mtx_destroy(&p_thread_manager_out->lock);
+        cat_free(p_task);
+        cat_free(p_thread_manager_out->p_worker);
+        cat_thread_mpmc_term(&p_thread_manager_out->queue);
+    }
+    assert_or_bail(done) false;
+    p_thread_manager_out->running = 1;
+    for (i = 0; i < count; ++i)
+    {
+        cat_thread_worker_t* const p_worker = &p_thread_manager_out->p_worker[i];
+        p_worker->p_task = p_task + i * CAT_THREAD_DEQUE_CAPACITY;
+        p_worker->mask = CAT_THREAD_DEQUE_CAPACITY - 1;
+        p_worker->p_manager = p_thread_manager_out;
+        p_worker->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+
+    // workers pick victims among all as soon as they start, so count is set first and cut back only on failure
+    p_thread_manager_out->num_threads = count;
+    if (p_thread_manager_out->placement != cat_thread_placement_none)
+        cat_mngr_internal_place(p_thread_manager_out, &topology);
+    for (i = 0; i < count; ++i)
+    {
+        if (thrd_create(&p_thread_manager_out->p_worker[i].thread, &cat_mngr_internal_worker, &p_thread_manager_out->p_worker[i]) != thrd_success)
+            break;
+    }
+    if (i < count)
+    {
+        p_thread_manager_out->num_threads = i;
+        cat_mngr_destroy(p_thread_manager_out);
+        return false;
+    }
+    return true;
+}
+
+cat_impl bool cat_mngr_destroy(cat_thread_manager_t* const p_thread_manager)
+{
+    size_t i = 0;
+    assert_or_bail(p_thread_manager) false;
+    assert_or_bail(p_thread_manager->p_worker) false;
+    cat_mngr_join_all_threads(p_thread_manager);
+    mtx_lock(&p_thread_manager->lock);
+    cat_thread_internal_store(&p_thread_manager->running, 0);
+    cnd_broadcast(&p_thread_manager->wake);
+    mtx_unlock(&p_thread_manager->lock);
+    for (i = 0; i < p_thread_manager->num_threads; ++i)
+        thrd_join(p_thread_manager->p_worker[i].thread, NULL);
+    cnd_destroy(&p_thread_manager->done);
+    cnd_destroy(&p_thread_manager->idle);
+    cnd_destroy(&p_thread_manager->wake);
+    mtx_destroy(&p_thread_manager->lock);
+    cat_free(p_thread_manager->p_worker[0].p_task);
+    cat_free(p_thread_manager->p_worker);
+    cat_thread_mpmc_term(&p_thread_manager->queue);
+    memset(p_thread_manager, 0, sizeof(*p_thread_manager));
+    return true;
+}
+
+cat_impl int cat_mngr_activate_thread(cat_thread_manager_t* const p_thread_manager, cat_thread_params_t const* const p_thread_params, cat_thread_completion_t* const p_completion_out)
+{
+    cat_thread_task_t task = { 0 };
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(p_thread_params) thrd_error;
+    assert_or_bail(p_thread_params->func) thrd_error;
+    if (p_completion_out)
+        memset(p_completion_out, 0, sizeof(*p_completion_out));
+    task.params = *p_thread_params;
+    task.p_group = &p_thread_manager->group;
+    task.p_completion = p_completion_out;
+    cat_thread_internal_add(&p_thread_manager->group.pending, 1);
+    cat_mngr_internal_submit(p_thread_manager, &task);
+    return thrd_success;
+}
+
+cat_impl int cat_mngr_then(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t* const p_completion, cat_thread_params_t const* const p_thread_params, cat_thread_completion_t* const p_completion_out)
+{
+    cat_thread_completion_t* p_continuation = NULL;
+    cat_thread_task_t task = { 0 };
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(p_completion) thrd_error;
+    assert_or_bail(p_thread_params) thrd_error;
+    assert_or_bail(p_thread_params->func) thrd_error;
+    assert_or_bail(p_completion_out && p_completion_out != p_completion) thrd_error;
+    memset(p_completion_out, 0, sizeof(*p_completion_out));
+    p_completion_out->params = *p_thread_params;
+
+    // counted now so joining waits for continuation not yet submitted
+    cat_thread_internal_add(&p_thread_manager->group.pending, 1);
+    p_continuation = (cat_thread_completion_t*)cat_thread_internal_load_ptr((void* volatile const*)&p_completion->p_continuation);
+    do
+    {
+        if (p_continuation == &threadCompletionClosed)
         {
-            // attempt name change
-            DWORD const exception = 0x406D1388;
-            RaiseException(exception, 0,
-                (sizeof(info) / sizeof(ULONG_PTR)),
-                (ULONG_PTR const*)(&info));
+            task.params = *p_thread_params;
+            task.p_group = &p_thread_manager->group;
+            task.p_completion = p_completion_out;
+            cat_mngr_internal_submit(p_thread_manager, &task);
+            break;
         }
-        __except (EXCEPTION_EXECUTE_HANDLER)
+        p_completion_out->p_next = p_continuation;
+    } while (!cat_thread_internal_cas_ptr((void* volatile*)&p_completion->p_continuation, (void**)&p_continuation, p_completion_out));
+    return thrd_success;
+}
+
+cat_impl int cat_mngr_spawn(cat_thread_manager_t* const p_thread_manager, cat_thread_params_t const* const p_thread_params, cat_thread_group_t* const p_group)
+{
+    cat_thread_task_t task = { 0 };
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(p_thread_params) thrd_error;
+    assert_or_bail(p_thread_params->func) thrd_error;
+    assert_or_bail(p_group) thrd_error;
+    task.params = *p_thread_params;
+    task.p_group = p_group;
+    cat_thread_internal_add(&p_group->pending, 1);
+    cat_mngr_internal_submit(p_thread_manager, &task);
+    return thrd_success;
+}
+
+cat_impl int cat_mngr_sync(cat_thread_manager_t* const p_thread_manager, cat_thread_group_t* const p_group)
+{
+    cat_thread_worker_t* const p_worker = (threadWorker && threadWorker->p_manager == p_thread_manager ? threadWorker : NULL);
+    cat_thread_task_t task = { 0 };
+    size_t spin = 0;
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(p_group) thrd_error;
+
+    // help instead of blocking; only give up time slice once nothing is left to take
+    while (cat_thread_internal_load(&p_group->pending))
+    {
+        if (cat_mngr_internal_find(p_thread_manager, p_worker, &task))
         {
-            // unhandled exception
+            cat_mngr_internal_run(p_thread_manager, &task);
+            spin = 0;
         }
-        result = true;
-#pragma warning(pop)
+        else if (++spin < CAT_THREAD_SPIN_COUNT)
+            cat_thread_internal_pause();
+        else
+            thrd_yield();
     }
-#else // #ifdef _WIN32
-    // Not supported.
-#endif // #else // #ifdef _WIN32
+    return cat_mngr_internal_result(p_group);
+}
+
+cat_impl bool cat_mngr_poll(cat_thread_completion_t const* const p_completion, int* const p_result_out)
+{
+    assert_or_bail(p_completion) false;
+    if (!cat_thread_internal_load(&p_completion->finished))
+        return false;
+    if (p_result_out)
+        *p_result_out = p_completion->result;
+    return true;
+}
+
+cat_impl int cat_mngr_wait(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const p_completion, uint32_t const timeout_ms, int* const p_result_out)
+{
+    int result = thrd_error;
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(p_completion) thrd_error;
+    result = cat_mngr_internal_wait(p_thread_manager, &p_completion, 1, true, timeout_ms, NULL);
+    if (result == thrd_success && p_result_out)
+        *p_result_out = p_completion->result;
     return result;
 }
 
+cat_impl int cat_mngr_wait_any(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const* const pp_completion, size_t const count, uint32_t const timeout_ms, size_t* const p_index_out)
+{
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(pp_completion && count) thrd_error;
+    return cat_mngr_internal_wait(p_thread_manager, pp_completion, count, false, timeout_ms, p_index_out);
+}
+
+cat_impl int cat_mngr_wait_all(cat_thread_manager_t* const p_thread_manager, cat_thread_completion_t const* const* const pp_completion, size_t const count, uint32_t const timeout_ms)
+{
+    assert_or_bail(p_thread_manager) thrd_error;
+    assert_or_bail(pp_completion || !count) thrd_error;
+    return cat_mngr_internal_wait(p_thread_manager, pp_completion, count, true, timeout_ms, NULL);
+}
+
+cat_impl int cat_mngr_join_all_threads(cat_thread_manager_t* const p_thread_manager)
+{
+    cat_thread_task_t task = { 0 };
+    size_t spin = 0;
+    assert_or_bail(p_thread_manager) thrd_error;
+
+    // help drain, then wait briefly for tasks still running before parking
+    while (cat_thread_internal_load(&p_thread_manager->group.pending) && cat_mngr_internal_find(p_thread_manager, NULL, &task))
+        cat_mngr_internal_run(p_thread_manager, &task);
+    while (cat_thread_internal_load(&p_thread_manager->group.pending) && ++spin < CAT_THREAD_SPIN_COUNT)
+        cat_thread_internal_pause();
+    mtx_lock(&p_thread_manager->lock);
+    while (cat_thread_internal_load(&p_thread_manager->group.pending))
+        cnd_wait(&p_thread_manager->idle, &p_thread_manager->lock);
+    mtx_unlock(&p_thread_manager->lock);
+    return cat_mngr_internal_result(&p_thread_manager->group);
+}
+//! \struct cat_parallel_job_s
+//! \brief Loop shared by all chunks of one parallel call.
+typedef struct cat_parallel_job_s
+{
+    cat_thread_manager_t*       p_thread_manager;//< Manager running chunks.
+    cat_parallel_for_func_t     func_for;        //< Loop body without value.
+    cat_parallel_reduce_func_t  func_reduce;     //< Loop body with value.
+    cat_parallel_combine_func_t combine;         //< Value combine function.
+    void*                       p_ctx;           //< Context passed to body.
+    void const*                 p_identity;      //< Initial value of each chunk.
+    size_t                      value_size;      //< Size of value in bytes.
+    size_t                      grain;           //< Largest chunk.
+    bool                        adaptive;        //< Split count follows stealing instead of grain.
+    uint8_t                     reserved[7];     //< Rounds size without implicit padding.
+} cat_parallel_job_t;
+
+static int cat_parallel_internal_range(size_t const argc, void* const argv[])
+{
+    // halve range: right half spawned for thieves, left half recursed here, value of right folded into left after sync
+    cat_parallel_job_t const* p_job = NULL;
+    cat_thread_group_t group = { 0 };
+    uint64_t value_right[CAT_PARALLEL_VALUE_SIZE / sizeof(uint64_t)] = { 0 };
+    void* p_value = NULL, * p_value_right = value_right;
+    size_t begin = 0, end = 0, middle = 0, depth = 0;
+    int result = 0;
+    assert_or_bail((argc == 6) && argv && argv[0] && argv[1] && argv[2] && argv[3]) thrd_error;
+    p_job = (cat_parallel_job_t const*)argv[0];
+    begin = *(size_t const*)argv[1];
+    end = *(size_t const*)argv[2];
+    depth = *(size_t const*)argv[3];
+    p_value = argv[4];
+
+    // chunk that reached other worker shows spare capacity, so it may be split further
+    if (p_job->adaptive && argv[5] != (void*)threadWorker)
+        depth += CAT_PARALLEL_STEAL_SPLITS;
+    if (!depth || end - begin <= p_job->grain)
+    {
+        if (p_job->func_reduce)
+            p_job->func_reduce(begin, end, p_job->p_ctx, p_value);
+        else
+            p_job->func_for(begin, end, p_job->p_ctx);
+        return thrd_success;
+    }
+    if (p_job->value_size > sizeof(value_right))
+    {
+        p_value_right = cat_malloc(p_job->value_size);
+        if (!p_value_right)
+            return thrd_error;
+    }
+    if (p_job->value_size)
+        memcpy(p_value_right, p_job->p_identity, p_job->value_size);
+    middle = begin + (end - begin) / 2;
+    --depth;
+    {
+        void* const args_right[] = { (void*)p_job, &middle, &end, &depth, p_value_right, threadWorker };
+        void* const args_left[] = { (void*)p_job, &begin, &middle, &depth, p_value, threadWorker };
+        cat_thread_params_t const params_right = { &cat_parallel_internal_range, array_count(args_right), args_right };
+        result |= cat_mngr_spawn(p_job->p_thread_manager, &params_right, &group);
+        result |= cat_parallel_internal_range(array_count(args_left), args_left);
+        result |= cat_mngr_sync(p_job->p_thread_manager, &group);
+    }
+    if (p_job->value_size)
+        p_job->combine(p_value, p_value_right, p_job->p_ctx);
+    if (p_value_right != value_right)
+        cat_free(p_value_right);
+    return (result ? thrd_error : thrd_success);
+}
+
+static bool cat_parallel_internal_run(cat_parallel_job_t* const p_job, size_t begin, size_t end, void* const p_value_out)
+{
+    // calling thread takes first chunk itself; automatic grain starts with few chunks per worker
+    size_t depth = SIZE_MAX, count = 1;
+    if (p_job->adaptive)
+    {
+        for (depth = CAT_PARALLEL_SPLITS_PER_WORKER; count < p_job->p_thread_manager->num_threads; count *= 2)
+            ++depth;
+        p_job->grain = 1;
+    }
+    if (p_value_out)
+        memcpy(p_value_out, p_job->p_identity, p_job->value_size);
+    if (begin >= end)
+        return true;
+    {
+        void* const args[] = { p_job, &begin, &end, &depth, p_value_out, threadWorker };
+        return (cat_parallel_internal_range(array_count(args), args) == thrd_success);
+    }
+}
+
+
+cat_impl bool cat_parallel_for(cat_thread_manager_t* const p_thread_manager, size_t const begin, size_t const end, size_t const grain,
+    cat_parallel_for_func_t const func, void* const p_ctx)
+{
+    cat_parallel_job_t job = { 0 };
+    assert_or_bail(p_thread_manager) false;
+    assert_or_bail(func) false;
+    job.p_thread_manager = p_thread_manager;
+    job.func_for = func;
+    job.p_ctx = p_ctx;
+    job.grain = grain;
+    job.adaptive = !grain;
+    return cat_parallel_internal_run(&job, begin, end, NULL);
+}
+
+cat_impl bool cat_parallel_reduce(cat_thread_manager_t* const p_thread_manager, size_t const begin, size_t const end, size_t const grain,
+    cat_parallel_reduce_func_t const func, cat_parallel_combine_func_t const combine, void* const p_ctx, void const* const p_identity, size_t const value_size, void* const p_value_out)
+{
+    cat_parallel_job_t job = { 0 };
+    assert_or_bail(p_thread_manager) false;
+    assert_or_bail(func) false;
+    assert_or_bail(combine) false;
+    assert_or_bail(p_identity && value_size && p_value_out) false;
+    job.p_thread_manager = p_thread_manager;
+    job.func_reduce = func;
+    job.combine = combine;
+    job.p_ctx = p_ctx;
+    job.p_identity = p_identity;
+    job.value_size = value_size;
+    job.grain = grain;
+    job.adaptive = !grain;
+    return cat_parallel_internal_run(&job, begin, end, p_value_out);
+}
+
 
 #include "cat/utility/cat_time.h"
 #include "cat/utility/cat_console.h"
@@ -173,6 +1622,289 @@ static int thrd_test_func(void* const arg)
     return 0;
 }
 
+//! \struct cat_thread_test_ring_s
+//! \brief State of ring test thread.
+typedef struct cat_thread_test_ring_s
+{
+    void*    p_ring;     //< Ring under test.
+    uint64_t id;         //< Producer index, placed in high bits of elements.
+    uint64_t count;      //< Number of elements to move.
+    uint64_t sum;        //< Sum of elements dequeued.
+    bool     mpmc;       //< Ring is multi-producer multi-consumer.
+    bool     ordered;    //< False if elements of any producer were dequeued out of order.
+    uint8_t  reserved[6];//< Rounds size without implicit padding.
+} cat_thread_test_ring_t;
+
+#define CAT_THREAD_TEST_RING_PRODUCERS 4
+#define CAT_THREAD_TEST_RING_ELEMENTS  (1 << 20)
+#define CAT_THREAD_TEST_RING_BATCH     8
+
+static size_t cat_thread_test_ring_move(cat_thread_test_ring_t const* const p_state, uint64_t* const p_elements, size_t const count, bool const produce)
+{
+    // single operations and batches take separate paths; test alternates between them
+    if (p_state->mpmc && produce)
+        return (count == 1 ? (size_t)cat_thread_mpmc_enqueue((cat_thread_mpmc_t*)p_state->p_ring, p_elements) : cat_thread_mpmc_enqueue_batch((cat_thread_mpmc_t*)p_state->p_ring, p_elements, count));
+    if (p_state->mpmc)
+        return (count == 1 ? (size_t)cat_thread_mpmc_dequeue((cat_thread_mpmc_t*)p_state->p_ring, p_elements) : cat_thread_mpmc_dequeue_batch((cat_thread_mpmc_t*)p_state->p_ring, p_elements, count));
+    if (produce)
+        return (count == 1 ? (size_t)cat_thread_spsc_enqueue((cat_thread_spsc_t*)p_state->p_ring, p_elements) : cat_thread_spsc_enqueue_batch((cat_thread_spsc_t*)p_state->p_ring, p_elements, count));
+    return (count == 1 ? (size_t)cat_thread_spsc_dequeue((cat_thread_spsc_t*)p_state->p_ring, p_elements) : cat_thread_spsc_dequeue_batch((cat_thread_spsc_t*)p_state->p_ring, p_elements, count));
+}
+
+static int cat_thread_test_ring_producer(size_t const argc, void* const argv[])
+{
+    cat_thread_test_ring_t* p_state = NULL;
+    uint64_t elements[CAT_THREAD_TEST_RING_BATCH] = { 0 };
+    uint64_t i = 0, j = 0, step = 0;
+    size_t count = 0;
+    assert_or_bail((argc == 1) && argv && argv[0]) 1;
+    p_state = (cat_thread_test_ring_t*)argv[0];
+    for (i = 0; i < p_state->count; i += count, ++step)
+    {
+        count = (size_t)((step & 1) && (p_state->count - i >= CAT_THREAD_TEST_RING_BATCH) ? CAT_THREAD_TEST_RING_BATCH : 1);
+        for (j = 0; j < count; ++j)
+            elements[j] = (p_state->id << 32) | (i + j);
+        count = cat_thread_test_ring_move(p_state, elements, count, true);
+        if (!count)
+            thrd_yield();
+    }
+    return 0;
+}
+
+static int cat_thread_test_ring_consumer(size_t const argc, void* const argv[])
+{
+    cat_thread_test_ring_t* p_state = NULL;
+    uint64_t elements[CAT_THREAD_TEST_RING_BATCH] = { 0 }, next[CAT_THREAD_TEST_RING_PRODUCERS] = { 0 };
+    uint64_t i = 0, j = 0, step = 0;
+    size_t count = 0;
+    assert_or_bail((argc == 1) && argv && argv[0]) 1;
+    p_state = (cat_thread_test_ring_t*)argv[0];
+    for (i = 0; i < p_state->count; i += count, ++step)
+    {
+        count = (size_t)((step & 1) && (p_state->count - i >= CAT_THREAD_TEST_RING_BATCH) ? CAT_THREAD_TEST_RING_BATCH : 1);
+        count = cat_thread_test_ring_move(p_state, elements, count, false);
+        if (!count)
+            thrd_yield();
+        for (j = 0; j < count; ++j)
+        {
+            // each consumer still sees any one producer's elements in order
+            p_state->ordered = p_state->ordered && ((elements[j] >> 32) < CAT_THREAD_TEST_RING_PRODUCERS) && ((elements[j] & 0xFFFFFFFF) >= next[elements[j] >> 32]);
+            if ((elements[j] >> 32) < CAT_THREAD_TEST_RING_PRODUCERS)
+                next[elements[j] >> 32] = (elements[j] & 0xFFFFFFFF) + 1;
+            p_state->sum += elements[j];
+        }
+    }
+    return 0;
+}
+
+#define CAT_THREAD_TEST_TASKS       100000
+#define CAT_THREAD_TEST_ROUND_TRIPS 10000
+
+static int cat_thread_test_count(size_t const argc, void* const argv[])
+{
+    // count run; fail if asked
+    assert_or_bail((argc == 2) && argv && argv[0]) 1;
+    cat_thread_internal_add((size_t volatile*)argv[0], 1);
+    return (argv[1] ? *(int const*)argv[1] : 0);
+}
+
+static int cat_thread_test_sleep(size_t const argc, void* const argv[])
+{
+    // sleep for milliseconds under one second, then return given value
+    struct timespec duration = { 0 };
+    assert_or_bail((argc == 2) && argv && argv[0] && argv[1]) 1;
+    duration.tv_nsec = (long)*(uint32_t const*)argv[0] * 1000000;
+    thrd_sleep(&duration, NULL);
+    return *(int const*)argv[1];
+}
+
+#define CAT_THREAD_TEST_FIB        32
+#define CAT_THREAD_TEST_FIB_SERIAL 16
+
+static uint64_t cat_thread_test_fib_serial(uint32_t const n)
+{
+    return (n < 2 ? n : cat_thread_test_fib_serial(n - 1) + cat_thread_test_fib_serial(n - 2));
+}
+
+static int cat_thread_test_fib(size_t const argc, void* const argv[])
+{
+    // divide and conquer: first half spawned onto own deque for thieves, second half computed here, then wait for first
+    cat_thread_manager_t* p_thread_manager = NULL;
+    cat_thread_group_t group = { 0 };
+    uint32_t n = 0, n1 = 0, n2 = 0;
+    uint64_t r1 = 0, r2 = 0;
+    int result = 0;
+    assert_or_bail((argc == 3) && argv && argv[0] && argv[1] && argv[2]) 1;
+    p_thread_manager = (cat_thread_manager_t*)argv[0];
+    n = *(uint32_t const*)argv[1];
+    if (n < CAT_THREAD_TEST_FIB_SERIAL)
+    {
+        *(uint64_t*)argv[2] = cat_thread_test_fib_serial(n);
+        return 0;
+    }
+    n1 = n - 1;
+    n2 = n - 2;
+    {
+        void* const args1[] = { p_thread_manager, &n1, &r1 };
+        void* const args2[] = { p_thread_manager, &n2, &r2 };
+        cat_thread_params_t const params1 = { &cat_thread_test_fib, array_count(args1), args1 };
+        result |= cat_mngr_spawn(p_thread_manager, &params1, &group);
+        result |= cat_thread_test_fib(array_count(args2), args2);
+        result |= cat_mngr_sync(p_thread_manager, &group);
+    }
+    *(uint64_t*)argv[2] = r1 + r2;
+    return result;
+}
+
+#define CAT_THREAD_TEST_PARALLEL (1 << 22)
+
+static void cat_thread_test_square(size_t const begin, size_t const end, void* const p_ctx)
+{
+    uint64_t* const p_data = (uint64_t*)p_ctx;
+    size_t i = 0;
+    for (i = begin; i < end; ++i)
+        p_data[i] = (uint64_t)i * i;
+}
+
+static void cat_thread_test_sum(size_t const begin, size_t const end, void* const p_ctx, void* const p_value)
+{
+    uint64_t const* const p_data = (uint64_t const*)p_ctx;
+    uint64_t sum = *(uint64_t*)p_value;
+    size_t i = 0;
+    for (i = begin; i < end; ++i)
+        sum += p_data[i];
+    *(uint64_t*)p_value = sum;
+}
+
+static void cat_thread_test_sum_combine(void* const p_value_lh, void const* const p_value_rh, void* const p_ctx)
+{
+    unused(p_ctx);
+    *(uint64_t*)p_value_lh += *(uint64_t const*)p_value_rh;
+}
+
+static void cat_thread_test_digest(size_t const begin, size_t const end, void* const p_ctx, void* const p_value)
+{
+    // polynomial digest of sequence; value is digest and multiplier spanning its length
+    uint64_t const* const p_data = (uint64_t const*)p_ctx;
+    uint64_t* const p_digest = (uint64_t*)p_value;
+    size_t i = 0;
+    for (i = begin; i < end; ++i)
+    {
+        p_digest[0] = p_digest[0] * 0x100000001B3ull + p_data[i];
+        p_digest[1] *= 0x100000001B3ull;
+    }
+}
+
+static void cat_thread_test_digest_combine(void* const p_value_lh, void const* const p_value_rh, void* const p_ctx)
+{
+    // associative but not commutative, so chunks must be combined in order
+    uint64_t* const p_lh = (uint64_t*)p_value_lh;
+    uint64_t const* const p_rh = (uint64_t const*)p_value_rh;
+    unused(p_ctx);
+    p_lh[0] = p_lh[0] * p_rh[1] + p_rh[0];
+    p_lh[1] *= p_rh[1];
+}
+
+static bool cat_thread_test_ring(void* const p_ring, bool const mpmc, size_t const producers, cat_time_t* const p_time_out)
+{
+    // producers and consumers in equal number each move equal share of elements
+    cat_thread_test_ring_t state[CAT_THREAD_TEST_RING_PRODUCERS * 2] = { 0 };
+    void* argv[CAT_THREAD_TEST_RING_PRODUCERS * 2] = { 0 };
+    cat_thread_params_t params[CAT_THREAD_TEST_RING_PRODUCERS * 2] = { 0 };
+    thrd_t thrd[CAT_THREAD_TEST_RING_PRODUCERS * 2] = { 0 };
+    uint64_t const count = CAT_THREAD_TEST_RING_ELEMENTS / producers;
+    uint64_t expect = 0, sum = 0;
+    size_t i = 0, started = 0;
+    bool result = true;
+    cat_time_t t = cat_platform_time();
+    for (i = 0; i < producers * 2; ++i)
+    {
+        state[i].p_ring = p_ring;
+        state[i].mpmc = mpmc;
+        state[i].id = i;
+        state[i].count = count;
+        state[i].ordered = true;
+        argv[i] = &state[i];
+        params[i].func = (i < producers ? &cat_thread_test_ring_producer : &cat_thread_test_ring_consumer);
+        params[i].argc = 1;
+        params[i].argv = &argv[i];
+        if (cat_thrd_create(&thrd[i], &params[i]) != thrd_success)
+            break;
+        ++started;
+    }
+    result = (started == producers * 2);
+    for (i = 0; i < started; ++i)
+        thrd_join(thrd[i], NULL);
+    *p_time_out = cat_platform_time() - t;
+    for (i = 0; i < producers; ++i)
+    {
+        expect += (((uint64_t)i << 32) * count) + (count * (count - 1) / 2);
+        sum += state[producers + i].sum;
+        result = result && state[producers + i].ordered;
+    }
+    return (result && sum == expect);
+}
+
+static int cat_thread_test_registry(size_t const argc, void* const argv[])
+{
+    // name self past system limit and burn some CPU, then find own entry besides manager workers; workers may have been renamed by tasks
+    cat_thread_manager_t const* p_thread_manager = NULL;
+    cat_thread_info_t* p_info = NULL;
+    size_t count = 0, i = 0, workers = 0;
+    uint64_t volatile sink = 0;
+    bool self = false, renamed = false;
+    assert_or_bail((argc == 2) && argv && argv[0] && argv[1]) 1;
+    p_thread_manager = (cat_thread_manager_t const*)argv[0];
+    renamed = cat_thread_rename("cat registry test");
+    for (i = 0; i < (1 << 22); ++i)
+        sink += i;
+    count = cat_thread_registry_query(NULL, 0);
+    p_info = (cat_thread_info_t*)cat_calloc(count, sizeof(cat_thread_info_t));
+    if (!p_info)
+        return 1;
+    count = cat_thread_registry_query(p_info, count);
+    for (i = 0; i < count; ++i)
+    {
+        if (!strcmp(p_info[i].name, "cat registry te") && p_info[i].tid && p_info[i].time_cpu_ns)
+            self = true;
+        else
+            ++workers;
+    }
+    cat_free(p_info);
+    *(size_t*)argv[1] = count;
+    return ((renamed && self && workers == p_thread_manager->num_threads) ? 0 : 1);
+}
+
+static int cat_thread_test_affinity(size_t const argc, void* const argv[])
+{
+    // report where thread may run and node it runs on
+    assert_or_bail((argc == 2) && argv && argv[0] && argv[1]) 1;
+    *(size_t*)argv[1] = cat_thread_current_node();
+    return (cat_thread_affinity_get((cat_thread_cpuset_t*)argv[0]) ? 0 : 1);
+}
+
+static bool cat_thread_test_placement(cat_thread_topology_t const* const p_topology, cat_thread_placement_t const placement)
+{
+    // every available processor is used exactly once across workers, and workers stay on their node
+    cat_thread_manager_t thread_manager;
+    cat_thread_cpuset_t used = { 0 };
+    size_t i = 0, cpu = 0, count = 0;
+    bool result = cat_mngr_create(&thread_manager, (placement == cat_thread_placement_node ? 0 : p_topology->num_cpus), placement);
+    for (i = 0; result && i < thread_manager.num_threads; ++i)
+        for (cpu = 0; cpu < CAT_THREAD_CPU_MAX; ++cpu)
+            if (cat_thread_cpuset_has(&thread_manager.p_worker[i].cpuset, cpu))
+            {
+                result = result && !cat_thread_cpuset_has(&used, cpu) && (p_topology->node[cpu] == thread_manager.p_worker[i].node);
+                cat_thread_cpuset_add(&used, cpu);
+                ++count;
+            }
+    result = result && (count == p_topology->num_cpus) && !memcmp(&used, &p_topology->available, sizeof(used));
+    result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_success);
+    if (thread_manager.p_worker)
+        cat_mngr_destroy(&thread_manager);
+    return result;
+}
+
 cat_noinl void cat_thread_test(void)
 {
     thrd_t thrd = { 0 };
@@ -188,7 +1920,7 @@ cat_noinl void cat_thread_test(void)
     };
 
     cat_thread_manager_t thread_manager;
-    cat_mngr_create(&thread_manager);
+    cat_mngr_create(&thread_manager, 0, cat_thread_placement_none);
 
     cat_console_clear();
     {
@@ -203,34 +1935,236 @@ cat_noinl void cat_thread_test(void)
     }
     {
         void* const args2[] = {
-        &thread_manager.inactive[0],       // thread object
+        &thrd,       // thread object
         __FUNCTION__,// thread name
         &print_count2,// print count
         };
         cat_thread_params_t const params2 = {
             &cat_thread_test_func, array_count(args2), args2
         };
-        thrd_res = cat_mngr_activate_thread(&thread_manager, &params2);
         void* const args3[] = {
-        &thread_manager.inactive[1],       // thread object
+        &thrd,       // thread object
         __FUNCTION__,// thread name
         &print_count3,// print count
         };
         cat_thread_params_t const params3 = {
             &cat_thread_test_func, array_count(args3), args3
         };
-        thrd_res2 = cat_mngr_activate_thread(&thread_manager, &params3);
         void* const args4[] = {
-        &thread_manager.inactive[2],       // thread object
+        &thrd,       // thread object
         __FUNCTION__,// thread name
         &print_count4,// print count
         };
         cat_thread_params_t const params4 = {
             &cat_thread_test_func, array_count(args4), args4
         };
-        thrd_res3 = cat_mngr_activate_thread(&thread_manager, &params4);
+        thrd_res = cat_mngr_activate_thread(&thread_manager, &params2, NULL);
+        thrd_res2 = cat_mngr_activate_thread(&thread_manager, &params3, NULL);
+        thrd_res3 = cat_mngr_activate_thread(&thread_manager, &params4, NULL);
         cat_mngr_join_all_threads(&thread_manager);
+    }
+    {
+        size_t volatile counter = 0;
+        int fail = 1;
+        void* const args_count[] = { (void*)&counter, NULL };
+        void* const args_fail[] = { (void*)&counter, &fail };
+        cat_thread_params_t const params_count = { &cat_thread_test_count, array_count(args_count), args_count };
+        cat_thread_params_t const params_fail = { &cat_thread_test_count, array_count(args_fail), args_fail };
+        cat_time_t t = 0, t_pool = 0, t_thrd = 0;
+        double const rate = (double)cat_platform_time_rate();
+        bool result = (thrd_res == thrd_success) && (thrd_res2 == thrd_success) && (thrd_res3 == thrd_success);
+        size_t i = 0;
+
+        // many small tasks through queue; all must run exactly once
+        t = cat_platform_time();
+        for (i = 0; i < CAT_THREAD_TEST_TASKS; ++i)
+            result = result && (cat_mngr_activate_thread(&thread_manager, &params_count, NULL) == thrd_success);
+        result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_success) && (counter == CAT_THREAD_TEST_TASKS);
+        t = cat_platform_time() - t;
+
+        // failing task reported by next join only
+        result = result && (cat_mngr_activate_thread(&thread_manager, &params_fail, NULL) == thrd_success);
+        result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_error);
+        result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_success);
+
+        // round trip of one task: pooled worker versus new thread
+        t_pool = cat_platform_time();
+        for (i = 0; i < CAT_THREAD_TEST_ROUND_TRIPS; ++i)
+        {
+            cat_mngr_activate_thread(&thread_manager, &params_count, NULL);
+            cat_mngr_join_all_threads(&thread_manager);
+        }
+        t_pool = cat_platform_time() - t_pool;
+        t_thrd = cat_platform_time();
+        for (i = 0; i < CAT_THREAD_TEST_ROUND_TRIPS / 100; ++i)
+        {
+            result = result && (cat_thrd_create(&thrd, &params_count) == thrd_success);
+            thrd_join(thrd, NULL);
+        }
+        t_thrd = cat_platform_time() - t_thrd;
+        result = result && (counter == CAT_THREAD_TEST_TASKS + CAT_THREAD_TEST_ROUND_TRIPS + CAT_THREAD_TEST_ROUND_TRIPS / 100 + 1);
+        printf("\nThread manager: %s (%"PRIu32" workers, %"PRIu32" tasks in %"PRIi64" ticks; round trip %.2f us pooled, %.2f us new thread)", result ? "Success" : "Failed",
+            (uint32_t)thread_manager.num_threads, CAT_THREAD_TEST_TASKS, t,
+            (double)t_pool * 1.0e6 / rate / CAT_THREAD_TEST_ROUND_TRIPS, (double)t_thrd * 1.0e6 / rate / (CAT_THREAD_TEST_ROUND_TRIPS / 100));
+    }
+    {
+        uint32_t slow_ms = 200, quick_ms = 1;
+        int slow_value = 3, quick_value = 7, result_task = 0;
+        size_t volatile counter = 0;
+        size_t index = 0;
+        void* const args_slow[] = { &slow_ms, &slow_value };
+        void* const args_quick[] = { &quick_ms, &quick_value };
+        void* const args_count[] = { (void*)&counter, NULL };
+        cat_thread_params_t const params_slow = { &cat_thread_test_sleep, array_count(args_slow), args_slow };
+        cat_thread_params_t const params_quick = { &cat_thread_test_sleep, array_count(args_quick), args_quick };
+        cat_thread_params_t const params_count = { &cat_thread_test_count, array_count(args_count), args_count };
+        cat_thread_completion_t quick = { 0 }, slow = { 0 }, then1 = { 0 }, then2 = { 0 }, then3 = { 0 };
+        cat_thread_completion_t const* const handles_any[] = { &slow, &quick };
+        cat_thread_completion_t const* const handles_all[] = { &quick, &then1, &then2 };
+        bool result = true;
+
+        // quick task ahead of slow one finishes first; slow one times out on short wait
+        result = result && (cat_mngr_activate_thread(&thread_manager, &params_quick, &quick) == thrd_success);
+        result = result && (cat_mngr_activate_thread(&thread_manager, &params_slow, &slow) == thrd_success);
+        result = result && (cat_mngr_wait_any(&thread_manager, handles_any, array_count(handles_any), CAT_THREAD_INFINITE, &index) == thrd_success) && (index == 1);
+        result = result && cat_mngr_poll(&quick, &result_task) && (result_task == quick_value);
+        result = result && !cat_mngr_poll(&slow, NULL);
+        result = result && (cat_mngr_wait(&thread_manager, &slow, 1, NULL) == thrd_timedout);
+
+        // continuations chained on running task and on finished one
+        result = result && (cat_mngr_then(&thread_manager, &slow, &params_count, &then1) == thrd_success);
+        result = result && (cat_mngr_then(&thread_manager, &then1, &params_count, &then2) == thrd_success);
+        result = result && (cat_mngr_then(&thread_manager, &quick, &params_count, &then3) == thrd_success);
+        result = result && (cat_mngr_wait(&thread_manager, &then3, CAT_THREAD_INFINITE, NULL) == thrd_success) && (counter >= 1);
+        result = result && (cat_mngr_wait_all(&thread_manager, handles_all, array_count(handles_all), CAT_THREAD_INFINITE) == thrd_success);
+        result = result && (counter == 3) && cat_mngr_poll(&slow, &result_task) && (result_task == slow_value);
+        result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_error);// nonzero task results count as failed
+        printf("\nThread completion: %s (any, all, timeout, %"PRIu32" continuations)", result ? "Success" : "Failed", (uint32_t)counter);
+    }
+    {
+        uint32_t n = CAT_THREAD_TEST_FIB;
+        uint64_t fib = 0, fib_serial = 0;
+        void* const args_fib[] = { &thread_manager, &n, &fib };
+        cat_thread_params_t const params_fib = { &cat_thread_test_fib, array_count(args_fib), args_fib };
+        cat_time_t t = 0, t_serial = 0;
+        size_t i = 0, steals = 0;
+        bool result = false;
+
+        // recursive tasks spawned from inside tasks; idle workers only get work by stealing
+        t_serial = cat_platform_time();
+        fib_serial = cat_thread_test_fib_serial(n);
+        t_serial = cat_platform_time() - t_serial;
+        t = cat_platform_time();
+        result = (cat_mngr_activate_thread(&thread_manager, &params_fib, NULL) == thrd_success);
+        result = result && (cat_mngr_join_all_threads(&thread_manager) == thrd_success) && (fib == fib_serial);
+        t = cat_platform_time() - t;
+        for (i = 0; i < thread_manager.num_threads; ++i)
+            steals += thread_manager.p_worker[i].steals;
+        printf("\nThread stealing: %s (fib(%"PRIu32") = %"PRIu64", %"PRIi64" ticks on %"PRIu32" workers vs %"PRIi64" serial, %"PRIu32" steals)", result ? "Success" : "Failed",
+            n, fib, t, (uint32_t)thread_manager.num_threads, t_serial, (uint32_t)steals);
+    }
+    {
+        uint64_t* const p_data = (uint64_t*)cat_calloc(CAT_THREAD_TEST_PARALLEL, sizeof(uint64_t));
+        uint64_t const zero = 0, digest_identity[2] = { 0, 1 };
+        uint64_t sum = 0, sum_auto = 0, sum_serial = 0, digest[2] = { 0 }, digest_serial[2] = { 0, 1 };
+        cat_time_t t = 0, t_serial = 0;
+        bool result = (p_data != NULL);
+
+        // fill with explicit grain, then sum with adaptive grain and compare to serial loop
+        result = result && cat_parallel_for(&thread_manager, 0, CAT_THREAD_TEST_PARALLEL, 4096, &cat_thread_test_square, p_data);
+        result = result && (p_data[CAT_THREAD_TEST_PARALLEL - 1] == (uint64_t)(CAT_THREAD_TEST_PARALLEL - 1) * (CAT_THREAD_TEST_PARALLEL - 1));
+        t_serial = cat_platform_time();
+        if (result)
+            cat_thread_test_sum(0, CAT_THREAD_TEST_PARALLEL, p_data, &sum_serial);
+        t_serial = cat_platform_time() - t_serial;
+        t = cat_platform_time();
+        result = result && cat_parallel_reduce(&thread_manager, 0, CAT_THREAD_TEST_PARALLEL, 0, &cat_thread_test_sum, &cat_thread_test_sum_combine, p_data, &zero, sizeof(sum), &sum_auto);
+        t = cat_platform_time() - t;
+        result = result && cat_parallel_reduce(&thread_manager, 0, CAT_THREAD_TEST_PARALLEL, 1000, &cat_thread_test_sum, &cat_thread_test_sum_combine, p_data, &zero, sizeof(sum), &sum);
+        result = result && (sum == sum_serial) && (sum_auto == sum_serial);
+
+        // order-sensitive reduction, odd range and empty range
+        if (result)
+            cat_thread_test_digest(3, CAT_THREAD_TEST_PARALLEL - 5, p_data, digest_serial);
+        result = result && cat_parallel_reduce(&thread_manager, 3, CAT_THREAD_TEST_PARALLEL - 5, 0, &cat_thread_test_digest, &cat_thread_test_digest_combine, p_data, digest_identity, sizeof(digest), digest);
+        result = result && !memcmp(digest, digest_serial, sizeof(digest));
+        result = result && cat_parallel_reduce(&thread_manager, 7, 7, 0, &cat_thread_test_digest, &cat_thread_test_digest_combine, p_data, digest_identity, sizeof(digest), digest);
+        result = result && !memcmp(digest, digest_identity, sizeof(digest));
+        cat_free(p_data);
+        printf("\nParallel for and reduce: %s (%"PRIu32" elements summed in %"PRIi64" ticks on %"PRIu32" workers vs %"PRIi64" serial)", result ? "Success" : "Failed",
+            CAT_THREAD_TEST_PARALLEL, t, (uint32_t)thread_manager.num_threads, t_serial);
+    }
+    {
+        size_t const count_before = cat_thread_registry_query(NULL, 0);
+        size_t count = 0, i = 0;
+        void* const args_registry[] = { &thread_manager, &count };
+        cat_thread_params_t const params_registry = { &cat_thread_test_registry, array_count(args_registry), args_registry };
+        cat_thread_info_t* const p_info = (cat_thread_info_t*)cat_calloc(count_before, sizeof(cat_thread_info_t));
+        uint64_t time_cpu_ns = 0;
+        bool result = (p_info != NULL);
+
+        // test thread is listed only while it runs; all other live entries are workers, read while they run
+        result = result && (cat_thrd_create(&thrd, &params_registry) == thrd_success);
+        result = result && (thrd_join(thrd, &thrd_res) == thrd_success) && (thrd_res == 0) && (count == count_before + 1);
+        result = result && (cat_thread_registry_query(p_info, count_before) == count_before);
+        for (i = 0; result && i < count_before; ++i)
+            time_cpu_ns += p_info[i].time_cpu_ns;
+        cat_free(p_info);
+        printf("\nThread registry: %s (%"PRIu32" live threads, %.1f ms CPU in workers)", result ? "Success" : "Failed",
+            (uint32_t)count_before, (double)time_cpu_ns / 1e6);
+    }
+    cat_mngr_destroy(&thread_manager);
+
+    {
+        cat_thread_topology_t topology = { 0 };
+        cat_thread_cpuset_t original = { 0 }, pinned = { 0 }, reported = { 0 };
+        size_t cpu = 0, node = 0;
+        void* const args_affinity[] = { &reported, &node };
+        cat_thread_params_t const params_affinity = { &cat_thread_test_affinity, array_count(args_affinity), args_affinity };
+        bool result = cat_thread_topology(&topology) && cat_thread_affinity_get(&original);
+
+        // pin to last available processor, then start thread pinned to same processor from its first instruction
+        for (cpu = CAT_THREAD_CPU_MAX; result && cpu > 0 && !cat_thread_cpuset_has(&topology.available, cpu - 1); --cpu);
+        result = result && (cpu > 0) && cat_thread_cpuset_add(&pinned, cpu - 1);
+        result = result && cat_thread_affinity_set(&pinned) && cat_thread_affinity_get(&reported) && !memcmp(&reported, &pinned, sizeof(pinned));
+        result = result && cat_thread_affinity_set(&original);
+        memset(&reported, 0, sizeof(reported));
+        result = result && (cat_thrd_create_pinned(&thrd, &params_affinity, &pinned) == thrd_success);
+        result = result && (thrd_join(thrd, &thrd_res) == thrd_success) && (thrd_res == 0) && !memcmp(&reported, &pinned, sizeof(pinned));
+        result = result && (node == topology.node[cpu - 1]);
+
+        // worker placements
+        result = result && cat_thread_test_placement(&topology, cat_thread_placement_compact);
+        result = result && cat_thread_test_placement(&topology, cat_thread_placement_scatter);
+        result = result && cat_thread_test_placement(&topology, cat_thread_placement_node);
+        printf("\nThread placement: %s (%"PRIu32" processors, %"PRIu32" nodes)", result ? "Success" : "Failed",
+            (uint32_t)topology.num_cpus, (uint32_t)topology.num_nodes);
+    }
+
+    {
+        cat_thread_spsc_t spsc = { 0 };
+        cat_thread_mpmc_t mpmc = { 0 };
+        cat_time_t t = 0, t2 = 0;
+        bool result = false, result2 = false;
+        uint64_t element = 0;
+
+        // single producer and consumer through small ring so both sides wrap and wait often
+        result = cat_thread_spsc_init(&spsc, NULL, sizeof(uint64_t), 1000);
+        result = result && (spsc.mask == 1023) && !cat_thread_spsc_dequeue(&spsc, &element);
+        result = result && (((uintptr_t)&spsc.head % CAT_THREAD_CACHE_LINE) == 0) && (((uintptr_t)&spsc.tail % CAT_THREAD_CACHE_LINE) == 0);
+        result = result && cat_thread_test_ring(&spsc, false, 1, &t);
+        result = result && !cat_thread_spsc_dequeue(&spsc, &element);
+        cat_thread_spsc_term(&spsc);
+        printf("\nRing (spsc): %s (%"PRIu32" elements, 1 producer, 1 consumer, %"PRIi64" ticks)", result ? "Success" : "Failed", CAT_THREAD_TEST_RING_ELEMENTS, t);
 
+        result2 = cat_thread_mpmc_init(&mpmc, NULL, sizeof(uint64_t), 1024);
+        result2 = result2 && (((uintptr_t)&mpmc.head % CAT_THREAD_CACHE_LINE) == 0) && (((uintptr_t)&mpmc.tail % CAT_THREAD_CACHE_LINE) == 0);
+        result2 = result2 && !cat_thread_mpmc_dequeue(&mpmc, &element);
+        result2 = result2 && cat_thread_test_ring(&mpmc, true, CAT_THREAD_TEST_RING_PRODUCERS, &t2);
+        result2 = result2 && !cat_thread_mpmc_dequeue(&mpmc, &element);
+        cat_thread_mpmc_term(&mpmc);
+        printf("\nRing (mpmc): %s (%"PRIu32" elements, %"PRIu32" producers, %"PRIu32" consumers, %"PRIi64" ticks)", result2 ? "Success" : "Failed",
+            CAT_THREAD_TEST_RING_ELEMENTS, CAT_THREAD_TEST_RING_PRODUCERS, CAT_THREAD_TEST_RING_PRODUCERS, t2);
     }
 
     cat_platform_sleep(cat_platform_time_rate());
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+/// Copyright 2025 Daniel S. Buckstein
+/// 
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// 
+///     http://www.apache.org/licenses/LICENSE-2.0
+/// 
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+* cat_vector.c
+* Dynamic array implementation.
+*/
+
+#include "cat/utility/cat_vector.h"
+#include "cat/cat_platform.inl"
+
+#include <string.h>
+
+
+cat_implementation_begin;
+
+
+static bool cat_vector_internal_storage(cat_vector_t* const p_vector, size_t const capacity)
+{
+    // resize storage to exact capacity; zero releases it
+    uint8_t* p_data = NULL;
+    if (capacity == p_vector->capacity)
+        return true;
+    if (!capacity)
+    {
+        cat_memory_allocator_dealloc(&p_vector->allocator, p_vector->p_data, p_vector->capacity * p_vector->element_size);
+        p_vector->p_data = NULL;
+        p_vector->capacity = 0;
+        return true;
+    }
+    if (capacity > SIZE_MAX / p_vector->element_size)
+        return false;
+    p_data = (uint8_t*)cat_memory_allocator_realloc(&p_vector->allocator, p_vector->p_data, p_vector->capacity * p_vector->element_size, capacity * p_vector->element_size);
+    if (!p_data)
+        return false;
+    p_vector->p_data = p_data;
+    p_vector->capacity = capacity;
+    return true;
+}
+
+static bool cat_vector_internal_grow(cat_vector_t* const p_vector, size_t const count)
+{
+    // grow by half again, or to what is needed if more
+    size_t capacity = p_vector->capacity;
+    if (count > SIZE_MAX - p_vector->count)
+        return false;
+    if (p_vector->count + count <= capacity)
+        return true;
+    capacity = (capacity > SIZE_MAX - capacity / 2 ? SIZE_MAX : capacity + capacity / 2);
+    capacity = (capacity > CAT_VECTOR_CAPACITY_MIN ? capacity : CAT_VECTOR_CAPACITY_MIN);
+    capacity = (capacity > p_vector->count + count ? capacity : p_vector->count + count);
+    return (cat_vector_internal_storage(p_vector, capacity) || cat_vector_internal_storage(p_vector, p_vector->count + count));
+}
+
+
+cat_impl bool cat_vector_init(cat_vector_t* const p_vector, cat_memory_allocator_t const* const p_allocator, size_t const element_size, size_t const capacity)
+{
+    assert_or_bail(p_vector) false;
+    assert_or_bail(element_size) false;
+    memset(p_vector, 0, sizeof(*p_vector));
+    p_vector->allocator = (p_allocator ? *p_allocator : cat_memory_allocator_heap());
+    p_vector->element_size = element_size;
+    return cat_vector_internal_storage(p_vector, capacity);
+}
+
+cat_impl bool cat_vector_term(cat_vector_t* const p_vector)
+{
+    assert_or_bail(p_vector) false;
+    if (p_vector->p_data)
+        cat_memory_allocator_dealloc(&p_vector->allocator, p_vector->p_data, p_vector->capacity * p_vector->element_size);
+    memset(p_vector, 0, sizeof(*p_vector));
+    return true;
+}
+
+cat_impl cat_vector_t* cat_vector_check(cat_vector_t* const p_vector, size_t const element_size)
+{
+    assert_or_bail(p_vector) NULL;
+    assert_or_bail(p_vector->element_size == element_size) NULL;
+    return p_vector;
+}
+
+cat_impl void* cat_vector_data(cat_vector_t const* const p_vector)
+{
+    assert_or_bail(p_vector) NULL;
+    return p_vector->p_data;
+}
+
+cat_impl void* cat_vector_at(cat_vector_t const* const p_vector, size_t const index)
+{
+    assert_or_bail(p_vector) NULL;
+    assert_or_bail(index < p_vector->count) NULL;
+    return (p_vector->p_data + index * p_vector->element_size);
+}
+
+cat_impl bool cat_vector_reserve(cat_vector_t* const p_vector, size_t const capacity)
+{
+    assert_or_bail(p_vector) false;
+    return (capacity <= p_vector->capacity || cat_vector_internal_storage(p_vector, capacity));
+}
+
+cat_impl bool cat_vector_shrink(cat_vector_t* const p_vector)
+{
+    assert_or_bail(p_vector) false;
+    return cat_vector_internal_storage(p_vector, p_vector->count);
+}
+
+cat_impl bool cat_vector_resize(cat_vector_t* const p_vector, size_t const count)
+{
+    assert_or_bail(p_vector) false;
+    if (count <= p_vector->count)
+    {
+        p_vector->count = count;
+        return true;
+    }
+    return (cat_vector_append(p_vector, NULL, count - p_vector->count) != NULL);
+}
+
+cat_impl bool cat_vector_clear(cat_vector_t* const p_vector)
+{
+    assert_or_bail(p_vector) false;
+    p_vector->count = 0;
+    return true;
+}
+
+cat_impl void* cat_vector_append(cat_vector_t* const p_vector, void const* const p_elements, size_t const count)
+{
+    assert_or_bail(p_vector) NULL;
+    return cat_vector_insert(p_vector, p_vector->count, p_elements, count);
+}
+
+cat_impl void* cat_vector_insert(cat_vector_t* const p_vector, size_t const index, void const* const p_elements, size_t const count)
+{
+    uint8_t* p_insert = NULL;
+    size_t size = 0;
+    assert_or_bail(p_vector) NULL;
+    assert_or_bail(index <= p_vector->count) NULL;
+    if (!count)
+        return (p_vector->p_data ? p_vector->p_data + index * p_vector->element_size : NULL);
+    if (!cat_vector_internal_grow(p_vector, count))
+        return NULL;
+
+    // later elements move up in one overlapping move, new elements are one block copy; single element skips kernel dispatch
+    size = count * p_vector->element_size;
+    p_insert = p_vector->p_data + index * p_vector->element_size;
+    if (index < p_vector->count)
+        memmove(p_insert + size, p_insert, (p_vector->count - index) * p_vector->element_size);
+    if (p_elements && count == 1)
+        memcpy(p_insert, p_elements, size);
+    else if (p_elements)
+        cat_memcpy(p_insert, p_elements, size);
+    else
+        cat_memclr(p_insert, size);
+    p_vector->count += count;
+    return p_insert;
+}
+
+cat_impl bool cat_vector_erase(cat_vector_t* const p_vector, size_t const index, size_t const count)
+{
+    uint8_t* p_erase = NULL;
+    assert_or_bail(p_vector) false;
+    assert_or_bail(index <= p_vector->count && count <= p_vector->count - index) false;
+    p_erase = p_vector->p_data + index * p_vector->element_size;
+    if (index + count < p_vector->count)
+        memmove(p_erase, p_erase + count * p_vector->element_size, (p_vector->count - index - count) * p_vector->element_size);
+    p_vector->count -= count;
+    return true;
+}
+
+cat_impl bool cat_vector_pop(cat_vector_t* const p_vector, void* const p_element_out)
+{
+    assert_or_bail(p_vector) false;
+    if (!p_vector->count)
+        return false;
+    --p_vector->count;
+    if (p_element_out)
+        cat_memcpy(p_element_out, p_vector->p_data + p_vector->count * p_vector->element_size, p_vector->element_size);
+    return true;
+}
+
+
+#include "cat/utility/cat_time.h"
+#include "cat/utility/cat_console.h"
+
+
+cat_noinl void cat_vector_test(void)
+{
+    cat_memory_pool_t pool;
+    cat_memory_arena_t arena;
+    cat_memory_allocator_t allocators[3];
+    cat_vector_t vector;
+    char const* const names[] = { "heap", "pool", "arena" };
+    uint32_t const values[] = { 100, 101, 102 };
+    uint32_t* p_values = NULL;
+    uint32_t i = 0, a = 0, moves = 0, value = 0;
+    uintptr_t p_prev = 0;
+    cat_time_t t = 0;
+    bool result = cat_memory_pool_init(&pool, 16 * 1024 * 1024) && cat_memory_arena_init(&arena, &pool, 8 * 1024 * 1024);
+    allocators[0] = cat_memory_allocator_heap();
+    allocators[1] = cat_memory_allocator_pool(&pool);
+    allocators[2] = cat_memory_allocator_arena(&arena);
+
+    // same operations through each allocator; growth is geometric so storage moves rarely
+    for (a = 0; result && a < array_count(allocators); ++a)
+    {
+        result = cat_vector_init_of(uint32_t, &vector, &allocators[a], 0);
+        t = cat_platform_time();
+        for (i = 0, moves = 0, p_prev = 0; result && i < 1000000; ++i)
+        {
+            result = (cat_vector_push_of(uint32_t, &vector, i) != NULL);
+            moves += ((uintptr_t)vector.p_data != p_prev);
+            p_prev = (uintptr_t)vector.p_data;
+        }
+        t = cat_platform_time() - t;
+
+        // bulk insert and erase in middle, then shrink keeps contents
+        // empty bulk operation is no-op that still reports insertion point
+        p_values = cat_vector_of(uint32_t, &vector);
+        result = result && p_values && (cat_vector_append(&vector, values, 0) == (void*)(p_values + vector.count)) &&
+            (cat_vector_insert(&vector, 10, NULL, 0) == (void*)(p_values + 10)) && (vector.count == 1000000) && (p_values[10] == 10);
+        result = result && cat_vector_insert(&vector, 10, values, array_count(values)) && cat_vector_erase(&vector, 0, 10) &&
+            cat_vector_erase(&vector, 3, 5) && cat_vector_pop(&vector, &value) && (value == 999999);
+        p_values = cat_vector_of(uint32_t, &vector);
+        result = result && p_values && (p_values[0] == 100) && (p_values[2] == 102) && (p_values[3] == 15) && (vector.count == 1000000 - 13);
+        for (i = 3; result && i < vector.count; ++i)
+            result = (p_values[i] == i + 12);
+        result = result && cat_vector_shrink(&vector) && (vector.capacity == vector.count) && (*cat_vector_at_of(uint32_t, &vector, 3) == 15) &&
+            cat_vector_resize(&vector, vector.count + 4) && !*cat_vector_at_of(uint32_t, &vector, vector.count - 1) &&
+            cat_vector_clear(&vector) && cat_vector_shrink(&vector) && !vector.p_data;
+
+        // released storage goes back to source: arena end rolls back, pool holds only arena
+        cat_vector_term(&vector);
+        result = result && !arena.offset && (pool.block_count == 1);
+        printf("\nVector (%s): %s (1000000 appends, %"PRIu32" moves, %"PRIi64" ticks)", names[a], result ? "Success" : "Failed", moves, t);
+    }
+
+    cat_memory_arena_term(&arena);
+    cat_memory_pool_term(&pool);
+}
+
+
+cat_implementation_end;
\ No newline at end of file